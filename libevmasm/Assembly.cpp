@@ -32,7 +32,10 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/JobScheduler.h>
+
 #include <fstream>
+#include <functional>
 #include <json/json.h>
 
 using namespace std;
@@ -41,6 +44,19 @@ using namespace solidity::evmasm;
 using namespace solidity::langutil;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Adds @a _assembly and all its (transitive) sub-assemblies to @a _assemblies.
+void collectAssemblies(Assembly const& _assembly, set<Assembly const*>& _assemblies)
+{
+	if (_assemblies.insert(&_assembly).second)
+		for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+			collectAssemblies(_assembly.sub(subId), _assemblies);
+}
+
+}
+
 AssemblyItem const& Assembly::append(AssemblyItem const& _i)
 {
 	assertThrow(m_deposit >= 0, AssemblyException, "Stack underflow.");
@@ -402,18 +418,43 @@ map<u256, u256> Assembly::optimiseInternal(
 )
 {
 	// Run optimisation for sub-assemblies.
+	OptimiserSettings settings = _settings;
+	// Disable creation mode for sub-assemblies.
+	settings.isCreation = false;
+	// The threads are shared among the sub-assemblies.
+	settings.threads = max<size_t>(1, _settings.threads / max<size_t>(1, m_subs.size()));
+
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	vector<function<void()>> jobs;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		jobs.emplace_back([&, subId, referencedTags = JumpdestRemover::referencedTags(m_items, subId)]() {
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(settings, referencedTags);
+		});
+
+	// Sub-assemblies can be shared. Jobs that reach a common assembly are run in the order
+	// of their IDs, so the result is the same as when optimising one after the other.
+	vector<set<size_t>> dependencies;
+	if (_settings.threads > 1 && m_subs.size() > 1)
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		vector<set<Assembly const*>> reachable(m_subs.size());
+		dependencies.resize(m_subs.size());
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		{
+			collectAssemblies(*m_subs[subId], reachable[subId]);
+			for (size_t otherId = 0; otherId < subId; ++otherId)
+				if (any_of(
+					reachable[subId].begin(),
+					reachable[subId].end(),
+					[&](Assembly const* _assembly) { return reachable[otherId].count(_assembly); }
+				))
+					dependencies[subId].insert(otherId);
+		}
 	}
+	runJobs(jobs, dependencies, _settings.threads);
+
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		// Apply the replacements (can be empty).
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -115,6 +115,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Maximum number of threads used to optimise sub-assemblies concurrently.
+		/// The result does not depend on this value.
+		size_t threads = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -28,6 +28,9 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <sstream>
 
 namespace solidity::evmasm
@@ -73,7 +76,7 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(_data);
 	}
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -92,8 +95,25 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+		{
+			m_smallData = 0;
+			m_largeData = std::make_shared<u256 const>(_data);
+		}
+	}
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
@@ -105,8 +125,10 @@ public:
 			return false;
 		if (type() == Operation)
 			return instruction() == _other.instruction();
+		else if (!m_largeData || !_other.m_largeData)
+			return m_smallData == _other.m_smallData && m_largeData == _other.m_largeData;
 		else
-			return data() == _other.data();
+			return m_largeData == _other.m_largeData || *m_largeData == *_other.m_largeData;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -116,6 +138,8 @@ public:
 			return type() < _other.type();
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
+		else if (!m_largeData && !_other.m_largeData)
+			return m_smallData < _other.m_smallData;
 		else
 			return data() < _other.data();
 	}
@@ -156,19 +180,22 @@ public:
 
 	size_t m_modifierDepth = 0;
 
-	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = std::make_shared<size_t>(_n); }
+	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
 
 private:
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
+	/// Data of items other than operations. Values that fit into 64 bits are stored inline
+	/// in m_smallData, larger values are stored in m_largeData, which is shared between copies.
+	uint64_t m_smallData = 0;
+	std::shared_ptr<u256 const> m_largeData;
 	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
 	mutable std::shared_ptr<u256> m_pushedValue;
 	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
-	mutable std::shared_ptr<size_t> m_immutableOccurrences;
+	mutable std::optional<size_t> m_immutableOccurrences;
 };
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength)
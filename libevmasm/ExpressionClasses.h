@@ -30,6 +30,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 
 namespace solidity::langutil
@@ -99,9 +100,8 @@ public:
 	/// @returns true if the value of the given class is known to be nonzero.
 	/// @note that this is not the negation of knownZero
 	bool knownNonZero(Id _c);
-	/// @returns a pointer to the value if the given class is known to be a constant,
-	/// and a nullptr otherwise.
-	u256 const* knownConstant(Id _c);
+	/// @returns the value if the given class is known to be a constant, and nullopt otherwise.
+	std::optional<u256> knownConstant(Id _c);
 
 	/// Stores a copy of the given AssemblyItem and returns a pointer to the copy that is valid for
 	/// the lifetime of the ExpressionClasses object.
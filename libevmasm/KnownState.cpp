@@ -26,6 +26,7 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libsolutil/Keccak256.h>
 
+#include <algorithm>
 #include <functional>
 
 using namespace std;
@@ -60,13 +61,13 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, eqClass);
 
 	_out << "Stack:" << endl;
-	for (auto const& it: m_stackElements)
+	for (auto const& it: *m_stackElements)
 	{
 		_out << "  " << dec << it.first << ": ";
 		streamExpressionClass(_out, it.second);
 	}
 	_out << "Storage:" << endl;
-	for (auto const& it: m_storageContent)
+	for (auto const& it: *m_storageContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -74,7 +75,7 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, it.second);
 	}
 	_out << "Memory:" << endl;
-	for (auto const& it: m_memoryContent)
+	for (auto const& it: *m_memoryContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -179,33 +180,52 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 					);
 			}
 		}
-		m_stackElements.erase(
-			m_stackElements.upper_bound(m_stackHeight + static_cast<int>(_item.deposit())),
-			m_stackElements.end()
-		);
 		m_stackHeight += static_cast<int>(_item.deposit());
+		if (m_stackElements->upper_bound(m_stackHeight) != m_stackElements->end())
+		{
+			map<int, Id>& stackElements = m_stackElements.mutate();
+			stackElements.erase(stackElements.upper_bound(m_stackHeight), stackElements.end());
+		}
 	}
 	return op;
 }
 
 /// Helper function for KnownState::reduceToCommonKnowledge, removes everything from
 /// _this which is not in or not equal to the value in _other.
-template <class Mapping> void intersect(Mapping& _this, Mapping const& _other)
+/// Does not copy _this if it shares its value with _other.
+template <class Mapping> void intersect(util::CopyOnWrite<Mapping>& _this, util::CopyOnWrite<Mapping> const& _other)
 {
-	for (auto it = _this.begin(); it != _this.end();)
-		if (_other.count(it->first) && _other.at(it->first) == it->second)
+	if (_this.sharesValueWith(_other))
+		return;
+	Mapping& mapping = _this.mutate();
+	for (auto it = mapping.begin(); it != mapping.end();)
+		if (_other->count(it->first) && _other->at(it->first) == it->second)
 			++it;
 		else
-			it = _this.erase(it);
+			it = mapping.erase(it);
 }
 
 void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers)
 {
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (_other.m_stackElements.count(it->first - stackDiff))
+	// The stack cannot change if both states still share it.
+	if (stackDiff != 0 || !m_stackElements.sharesValueWith(_other.m_stackElements))
+		reduceStackToCommonKnowledge(_other);
+
+	intersect(m_storageContent, _other.m_storageContent);
+	intersect(m_memoryContent, _other.m_memoryContent);
+	if (_combineSequenceNumbers)
+		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
+}
+
+void KnownState::reduceStackToCommonKnowledge(KnownState const& _other)
+{
+	int stackDiff = m_stackHeight - _other.m_stackHeight;
+	map<int, Id>& stackElements = m_stackElements.mutate();
+	for (auto it = stackElements.begin(); it != stackElements.end();)
+		if (_other.m_stackElements->count(it->first - stackDiff))
 		{
-			Id other = _other.m_stackElements.at(it->first - stackDiff);
+			Id other = _other.m_stackElements->at(it->first - stackDiff);
 			if (it->second == other)
 				++it;
 			else
@@ -219,26 +239,21 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 					++it;
 				}
 				else
-					it = m_stackElements.erase(it);
+					it = stackElements.erase(it);
 			}
 		}
 		else
-			it = m_stackElements.erase(it);
+			it = stackElements.erase(it);
 
 	// Use the smaller stack height. Essential to terminate in case of loops.
 	if (m_stackHeight > _other.m_stackHeight)
 	{
 		map<int, Id> shiftedStack;
-		for (auto const& stackElement: m_stackElements)
+		for (auto const& stackElement: stackElements)
 			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
-		m_stackElements = move(shiftedStack);
+		stackElements = move(shiftedStack);
 		m_stackHeight = _other.m_stackHeight;
 	}
-
-	intersect(m_storageContent, _other.m_storageContent);
-	intersect(m_memoryContent, _other.m_memoryContent);
-	if (_combineSequenceNumbers)
-		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
 }
 
 bool KnownState::operator==(KnownState const& _other) const
@@ -246,20 +261,22 @@ bool KnownState::operator==(KnownState const& _other) const
 	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
 		return false;
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	auto thisIt = m_stackElements.cbegin();
-	auto otherIt = _other.m_stackElements.cbegin();
-	for (; thisIt != m_stackElements.cend() && otherIt != _other.m_stackElements.cend(); ++thisIt, ++otherIt)
+	if (stackDiff == 0 && m_stackElements.sharesValueWith(_other.m_stackElements))
+		return true;
+	auto thisIt = m_stackElements->cbegin();
+	auto otherIt = _other.m_stackElements->cbegin();
+	for (; thisIt != m_stackElements->cend() && otherIt != _other.m_stackElements->cend(); ++thisIt, ++otherIt)
 		if (thisIt->first - stackDiff != otherIt->first || thisIt->second != otherIt->second)
 			return false;
-	return (thisIt == m_stackElements.cend() && otherIt == _other.m_stackElements.cend());
+	return (thisIt == m_stackElements->cend() && otherIt == _other.m_stackElements->cend());
 }
 
 ExpressionClasses::Id KnownState::stackElement(int _stackHeight, SourceLocation const& _location)
 {
-	if (m_stackElements.count(_stackHeight))
-		return m_stackElements.at(_stackHeight);
+	if (m_stackElements->count(_stackHeight))
+		return m_stackElements->at(_stackHeight);
 	// Stack element not found (not assigned yet), create new unknown equivalence class.
-	return m_stackElements[_stackHeight] =
+	return m_stackElements.mutate()[_stackHeight] =
 			m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
 }
 
@@ -270,16 +287,21 @@ KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation
 
 void KnownState::clearTagUnions()
 {
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (m_tagUnions.left.count(it->second))
-			it = m_stackElements.erase(it);
+	if (none_of(m_stackElements->begin(), m_stackElements->end(), [&](auto const& _element) {
+		return m_tagUnions->left.count(_element.second) > 0;
+	}))
+		return;
+	map<int, Id>& stackElements = m_stackElements.mutate();
+	for (auto it = stackElements.begin(); it != stackElements.end();)
+		if (m_tagUnions->left.count(it->second))
+			it = stackElements.erase(it);
 		else
 			++it;
 }
 
 void KnownState::setStackElement(int _stackHeight, Id _class)
 {
-	m_stackElements[_stackHeight] = _class;
+	m_stackElements.mutate()[_stackHeight] = _class;
 }
 
 void KnownState::swapStackElements(
@@ -293,7 +315,8 @@ void KnownState::swapStackElements(
 	stackElement(_stackHeightA, _location);
 	stackElement(_stackHeightB, _location);
 
-	swap(m_stackElements[_stackHeightA], m_stackElements[_stackHeightB]);
+	map<int, Id>& stackElements = m_stackElements.mutate();
+	swap(stackElements[_stackHeightA], stackElements[_stackHeightB]);
 }
 
 KnownState::StoreOperation KnownState::storeInStorage(
@@ -301,23 +324,23 @@ KnownState::StoreOperation KnownState::storeInStorage(
 	Id _value,
 	SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot) && m_storageContent[_slot] == _value)
+	if (m_storageContent->count(_slot) && m_storageContent->at(_slot) == _value)
 		// do not execute the storage if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_storageContent) storageContents;
+	map<Id, Id> storageContents;
 	// Copy over all values (i.e. retain knowledge about them) where we know that this store
 	// operation will not destroy the knowledge. Specifically, we copy storage locations we know
 	// are different from _slot or locations where we know that the stored value is equal to _value.
-	for (auto const& storageItem: m_storageContent)
+	for (auto const& storageItem: *m_storageContent)
 		if (m_expressionClasses->knownToBeDifferent(storageItem.first, _slot) || storageItem.second == _value)
 			storageContents.insert(storageItem);
-	m_storageContent = move(storageContents);
 
 	AssemblyItem item(Instruction::SSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Storage, _slot, m_sequenceNumber, id};
-	m_storageContent[_slot] = _value;
+	storageContents[_slot] = _value;
+	m_storageContent = util::CopyOnWrite<map<Id, Id>>(move(storageContents));
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 
@@ -326,30 +349,30 @@ KnownState::StoreOperation KnownState::storeInStorage(
 
 ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot))
-		return m_storageContent.at(_slot);
+	if (m_storageContent->count(_slot))
+		return m_storageContent->at(_slot);
 
 	AssemblyItem item(Instruction::SLOAD, _location);
-	return m_storageContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_storageContent.mutate()[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
 KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot) && m_memoryContent[_slot] == _value)
+	if (m_memoryContent->count(_slot) && m_memoryContent->at(_slot) == _value)
 		// do not execute the store if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_memoryContent) memoryContents;
+	map<Id, Id> memoryContents;
 	// copy over values at points where we know that they are different from _slot by at least 32
-	for (auto const& memoryItem: m_memoryContent)
+	for (auto const& memoryItem: *m_memoryContent)
 		if (m_expressionClasses->knownToBeDifferentBy32(memoryItem.first, _slot))
 			memoryContents.insert(memoryItem);
-	m_memoryContent = move(memoryContents);
 
 	AssemblyItem item(Instruction::MSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Memory, _slot, m_sequenceNumber, id};
-	m_memoryContent[_slot] = _value;
+	memoryContents[_slot] = _value;
+	m_memoryContent = util::CopyOnWrite<map<Id, Id>>(move(memoryContents));
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 	return operation;
@@ -357,11 +380,11 @@ KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, Source
 
 ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot))
-		return m_memoryContent.at(_slot);
+	if (m_memoryContent->count(_slot))
+		return m_memoryContent->at(_slot);
 
 	AssemblyItem item(Instruction::MLOAD, _location);
-	return m_memoryContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_memoryContent.mutate()[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
 KnownState::Id KnownState::applyKeccak256(
@@ -372,7 +395,7 @@ KnownState::Id KnownState::applyKeccak256(
 {
 	AssemblyItem keccak256Item(Instruction::KECCAK256, _location);
 	// Special logic if length is a short constant, otherwise we cannot tell.
-	u256 const* l = m_expressionClasses->knownConstant(_length);
+	optional<u256> l = m_expressionClasses->knownConstant(_length);
 	// unknown or too large length
 	if (!l || *l > 128)
 		return m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
@@ -386,8 +409,8 @@ KnownState::Id KnownState::applyKeccak256(
 		);
 		arguments.push_back(loadFromMemory(slot, _location));
 	}
-	if (m_knownKeccak256Hashes.count(arguments))
-		return m_knownKeccak256Hashes.at(arguments);
+	if (m_knownKeccak256Hashes->count(arguments))
+		return m_knownKeccak256Hashes->at(arguments);
 	Id v;
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
@@ -400,13 +423,13 @@ KnownState::Id KnownState::applyKeccak256(
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
-	return m_knownKeccak256Hashes[arguments] = v;
+	return m_knownKeccak256Hashes.mutate()[arguments] = v;
 }
 
 set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 {
-	if (m_tagUnions.left.count(_expressionId))
-		return m_tagUnions.left.at(_expressionId);
+	if (m_tagUnions->left.count(_expressionId))
+		return m_tagUnions->left.at(_expressionId);
 	// Might be a tag, then return the set of itself.
 	ExpressionClasses::Expression expr = m_expressionClasses->representative(_expressionId);
 	if (expr.item && expr.item->type() == PushTag)
@@ -417,12 +440,12 @@ set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 
 KnownState::Id KnownState::tagUnion(set<u256> _tags)
 {
-	if (m_tagUnions.right.count(_tags))
-		return m_tagUnions.right.at(_tags);
+	if (m_tagUnions->right.count(_tags))
+		return m_tagUnions->right.at(_tags);
 	else
 	{
 		Id id = m_expressionClasses->newClass(SourceLocation());
-		m_tagUnions.right.insert(make_pair(_tags, id));
+		m_tagUnions.mutate().right.insert(make_pair(_tags, id));
 		return id;
 	}
 }
@@ -44,6 +44,7 @@
 #endif // defined(__clang__)
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/CopyOnWrite.h>
 #include <libsolutil/Exceptions.h>
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SemanticInformation.h>
@@ -66,6 +67,8 @@ using AssemblyItems = std::vector<AssemblyItem>;
  * The general workings are that for each assembly item that is fed, an equivalence class is
  * derived from the operation and the equivalence class of its arguments. DUPi, SWAPi and some
  * arithmetic instructions are used to infer equivalences while these classes are determined.
+ *
+ * Copies share their knowledge until it is modified, so that copying a state is cheap.
  */
 class KnownState
 {
@@ -97,11 +100,11 @@ public:
 	StoreOperation feedItem(AssemblyItem const& _item, bool _copyItem = false);
 
 	/// Resets any knowledge about storage.
-	void resetStorage() { m_storageContent.clear(); }
+	void resetStorage() { m_storageContent = {}; }
 	/// Resets any knowledge about storage.
-	void resetMemory() { m_memoryContent.clear(); }
+	void resetMemory() { m_memoryContent = {}; }
 	/// Resets any knowledge about the current stack.
-	void resetStack() { m_stackElements.clear(); m_stackHeight = 0; }
+	void resetStack() { m_stackElements = {}; m_stackHeight = 0; }
 	/// Resets any knowledge.
 	void reset() { resetStorage(); resetMemory(); resetStack(); }
 
@@ -113,7 +116,8 @@ public:
 	/// @param _combineSequenceNumbers if true, sets the sequence number to the maximum of both
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
-	/// @returns a shared pointer to a copy of this state.
+	/// @returns a shared pointer to a copy of this state. The copy shares the knowledge with
+	/// this state until one of them is modified.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
@@ -133,12 +137,14 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	std::map<int, Id> const& stackElements() const { return *m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& storageContent() const { return *m_storageContent; }
 
 private:
+	/// Stack part of reduceToCommonKnowledge.
+	void reduceStackToCommonKnowledge(KnownState const& _other);
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
 	void setStackElement(int _stackHeight, Id _class);
 	/// Swaps the given stack elements in their next sequence number.
@@ -165,20 +171,20 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	util::CopyOnWrite<std::map<int, Id>> m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	util::CopyOnWrite<std::map<Id, Id>> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	util::CopyOnWrite<std::map<Id, Id>> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed.
-	std::map<std::vector<Id>, Id> m_knownKeccak256Hashes;
+	util::CopyOnWrite<std::map<std::vector<Id>, Id>> m_knownKeccak256Hashes;
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	util::CopyOnWrite<boost::bimap<Id, std::set<u256>>> m_tagUnions;
 };
 
 }
@@ -81,22 +81,36 @@ char CharStream::setPosition(size_t _location)
 	return get();
 }
 
+vector<size_t> const& CharStream::lineStarts() const
+{
+	shared_ptr<vector<size_t> const> lineStarts = atomic_load(&m_lineStarts);
+	if (!lineStarts)
+	{
+		auto starts = make_shared<vector<size_t>>(1, 0);
+		for (size_t position = 0; position < m_source.size(); ++position)
+			if (m_source[position] == '\n')
+				starts->push_back(position + 1);
+		// The index is never replaced once it is set, so the returned reference stays valid.
+		shared_ptr<vector<size_t> const> expected;
+		if (atomic_compare_exchange_strong(&m_lineStarts, &expected, shared_ptr<vector<size_t> const>(move(starts))))
+			lineStarts = atomic_load(&m_lineStarts);
+		else
+			lineStarts = move(expected);
+	}
+	return *lineStarts;
+}
+
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	vector<size_t> const& starts = lineStarts();
+	size_t searchPosition = min<size_t>(m_source.size(), size_t(_position));
+	if (searchPosition > 0 && m_source[searchPosition - 1] != '\n')
+		searchPosition--;
+	size_t lineNumber = static_cast<size_t>(upper_bound(starts.begin(), starts.end(), searchPosition) - starts.begin()) - 1;
+	size_t lineStart = starts[lineNumber];
+	size_t lineEnd = lineNumber + 1 < starts.size() ? starts[lineNumber + 1] - 1 : m_source.size();
+	string line = m_source.substr(lineStart, lineEnd - lineStart);
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -104,17 +118,8 @@ string CharStream::lineAtPosition(int _position) const
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	vector<size_t> const& starts = lineStarts();
+	size_t searchPosition = min<size_t>(m_source.size(), size_t(_position));
+	size_t lineNumber = static_cast<size_t>(upper_bound(starts.begin(), starts.end(), searchPosition) - starts.begin()) - 1;
+	return tuple<int, int>(static_cast<int>(lineNumber), static_cast<int>(searchPosition - starts[lineNumber]));
 }
@@ -53,9 +53,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -90,10 +92,14 @@ public:
 	std::string const& source() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
+	/// @returns the offsets of the first characters of all lines, starting with zero.
+	/// Computed on first use and shared by all copies of the stream.
+	std::vector<size_t> const& lineStarts() const;
+
 	///@{
 	///@name Error printing helper functions
-	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Functions that help pretty-printing parse errors and translating source locations.
+	/// They use the index of line starts and take logarithmic time.
 	std::string lineAtPosition(int _position) const;
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
@@ -116,6 +122,8 @@ private:
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Cache for lineStarts(), only accessed atomically.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
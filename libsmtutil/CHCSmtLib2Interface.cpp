@@ -18,6 +18,8 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string/join.hpp>
@@ -96,10 +98,12 @@ pair<CheckResult, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expre
 		declareVariable(var.first, var.second);
 	m_accumulatedOutput += accumulated;
 
-	string response = querySolver(
-		m_accumulatedOutput +
-		"\n(query " + _block.name + " :print-certificate true)"
-	);
+	string query = m_accumulatedOutput + "\n(query " + _block.name + " :print-certificate true)";
+	if (m_queryCache)
+		if (auto cached = m_queryCache->load("smtlib2", query))
+			return {cached->first, {}};
+
+	string response = querySolver(query);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -113,6 +117,8 @@ pair<CheckResult, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expre
 		result = CheckResult::ERROR;
 
 	// TODO collect invariants or counterexamples.
+	if (m_queryCache)
+		m_queryCache->store("smtlib2", query, result, Json::nullValue);
 	return {result, {}};
 }
 
@@ -25,11 +25,14 @@
 #include <libsmtutil/SolverInterface.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+class QueryCache;
+
 class CHCSolverInterface
 {
 public:
@@ -59,8 +62,13 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Sets a cache that is consulted before the solver is queried
+	/// and that stores its answers.
+	void setQueryCache(std::shared_ptr<QueryCache> _queryCache) { m_queryCache = std::move(_queryCache); }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	std::shared_ptr<QueryCache> m_queryCache;
 };
 
 }
@@ -20,6 +20,7 @@
 
 #include <libsolutil/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -27,6 +28,11 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::smtutil;
 
+string CVC4Interface::version()
+{
+	return "cvc4 " + CVC4::Configuration::getVersionString();
+}
+
 CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(&m_context)
@@ -121,6 +127,18 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	try
+	{
+		m_solver.interrupt();
+	}
+	catch (CVC4::Exception const&)
+	{
+		// The query has already finished.
+	}
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
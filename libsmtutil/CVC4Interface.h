@@ -42,6 +42,9 @@ class CVC4Interface: public SolverInterface, public boost::noncopyable
 public:
 	CVC4Interface(std::optional<unsigned> _queryTimeout = {});
 
+	/// @returns the name and version of the CVC4 library in use.
+	static std::string version();
+
 	void reset() override;
 
 	void push() override;
@@ -51,6 +54,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
@@ -0,0 +1,283 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+util::h256 entryKey(string const& _solver, string const& _query)
+{
+	return util::keccak256(_solver + '\0' + _query);
+}
+
+Json::Value sortToJson(Sort const& _sort)
+{
+	Json::Value json{Json::objectValue};
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		json["kind"] = "int";
+		json["signed"] = dynamic_cast<IntSort const&>(_sort).isSigned;
+		break;
+	case Kind::Bool:
+		json["kind"] = "bool";
+		break;
+	case Kind::BitVector:
+		json["kind"] = "bitvector";
+		json["size"] = dynamic_cast<BitVectorSort const&>(_sort).size;
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		json["kind"] = "function";
+		json["domain"] = Json::arrayValue;
+		for (auto const& sort: functionSort.domain)
+			json["domain"].append(sortToJson(*sort));
+		json["codomain"] = sortToJson(*functionSort.codomain);
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		json["kind"] = "array";
+		json["domain"] = sortToJson(*arraySort.domain);
+		json["range"] = sortToJson(*arraySort.range);
+		break;
+	}
+	case Kind::Sort:
+		json["kind"] = "sort";
+		json["inner"] = sortToJson(*dynamic_cast<SortSort const&>(_sort).inner);
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		json["kind"] = "tuple";
+		json["name"] = tupleSort.name;
+		json["members"] = Json::arrayValue;
+		for (auto const& member: tupleSort.members)
+			json["members"].append(member);
+		json["components"] = Json::arrayValue;
+		for (auto const& sort: tupleSort.components)
+			json["components"].append(sortToJson(*sort));
+		break;
+	}
+	}
+	return json;
+}
+
+/// @returns the sort encoded in @a _json or nullptr if it is malformed.
+SortPointer sortFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["kind"].isString())
+		return nullptr;
+	string const kind = _json["kind"].asString();
+	if (kind == "int" && _json["signed"].isBool())
+		return SortProvider::intSort(_json["signed"].asBool());
+	else if (kind == "bool")
+		return SortProvider::boolSort;
+	else if (kind == "bitvector" && _json["size"].isUInt())
+		return make_shared<BitVectorSort>(_json["size"].asUInt());
+	else if (kind == "function" && _json["domain"].isArray())
+	{
+		vector<SortPointer> domain;
+		for (auto const& sort: _json["domain"])
+			if (!domain.emplace_back(sortFromJson(sort)))
+				return nullptr;
+		if (SortPointer codomain = sortFromJson(_json["codomain"]))
+			return make_shared<FunctionSort>(move(domain), move(codomain));
+	}
+	else if (kind == "array")
+	{
+		SortPointer domain = sortFromJson(_json["domain"]);
+		SortPointer range = sortFromJson(_json["range"]);
+		if (domain && range)
+			return make_shared<ArraySort>(move(domain), move(range));
+	}
+	else if (kind == "sort")
+	{
+		if (SortPointer inner = sortFromJson(_json["inner"]))
+			return make_shared<SortSort>(move(inner));
+	}
+	else if (
+		kind == "tuple" &&
+		_json["name"].isString() &&
+		_json["members"].isArray() &&
+		_json["components"].isArray() &&
+		_json["members"].size() == _json["components"].size()
+	)
+	{
+		vector<string> members;
+		for (auto const& member: _json["members"])
+		{
+			if (!member.isString())
+				return nullptr;
+			members.emplace_back(member.asString());
+		}
+		vector<SortPointer> components;
+		for (auto const& sort: _json["components"])
+			if (!components.emplace_back(sortFromJson(sort)))
+				return nullptr;
+		return make_shared<TupleSort>(_json["name"].asString(), move(members), move(components));
+	}
+	return nullptr;
+}
+
+Json::Value expressionToJson(Expression const& _expr)
+{
+	Json::Value json{Json::objectValue};
+	json["name"] = _expr.name;
+	json["sort"] = sortToJson(*_expr.sort);
+	if (!_expr.arguments.empty())
+	{
+		json["arguments"] = Json::arrayValue;
+		for (auto const& argument: _expr.arguments)
+			json["arguments"].append(expressionToJson(argument));
+	}
+	return json;
+}
+
+optional<Expression> expressionFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["name"].isString())
+		return nullopt;
+	SortPointer sort = sortFromJson(_json["sort"]);
+	if (!sort)
+		return nullopt;
+	vector<Expression> arguments;
+	if (_json.isMember("arguments"))
+	{
+		if (!_json["arguments"].isArray())
+			return nullopt;
+		for (auto const& argument: _json["arguments"])
+		{
+			optional<Expression> expr = expressionFromJson(argument);
+			if (!expr)
+				return nullopt;
+			arguments.emplace_back(move(*expr));
+		}
+	}
+	return Expression(_json["name"].asString(), move(arguments), move(sort));
+}
+
+}
+
+optional<pair<CheckResult, Json::Value>> QueryCache::load(string const& _solver, string const& _query) const
+{
+	optional<Json::Value> entry = m_store.load(entryKey(_solver, _query));
+	if (!entry || (*entry)["solver"] != _solver)
+		return nullopt;
+
+	if ((*entry)["result"] == "sat")
+		return {{CheckResult::SATISFIABLE, (*entry)["model"]}};
+	else if ((*entry)["result"] == "unsat")
+		return {{CheckResult::UNSATISFIABLE, (*entry)["model"]}};
+	return nullopt;
+}
+
+void QueryCache::store(string const& _solver, string const& _query, CheckResult _result, Json::Value const& _model) const
+{
+	if (_result != CheckResult::SATISFIABLE && _result != CheckResult::UNSATISFIABLE)
+		return;
+
+	Json::Value entry{Json::objectValue};
+	entry["solver"] = _solver;
+	entry["result"] = _result == CheckResult::SATISFIABLE ? "sat" : "unsat";
+	entry["model"] = _model;
+	m_store.store(entryKey(_solver, _query), move(entry));
+}
+
+Json::Value QueryCache::valuesToJson(vector<string> const& _values)
+{
+	Json::Value json{Json::arrayValue};
+	for (auto const& value: _values)
+		json.append(value);
+	return json;
+}
+
+optional<vector<string>> QueryCache::valuesFromJson(Json::Value const& _json)
+{
+	if (!_json.isArray())
+		return nullopt;
+	vector<string> values;
+	for (auto const& value: _json)
+	{
+		if (!value.isString())
+			return nullopt;
+		values.emplace_back(value.asString());
+	}
+	return values;
+}
+
+Json::Value QueryCache::counterexampleToJson(CHCSolverInterface::CexGraph const& _graph)
+{
+	Json::Value json{Json::objectValue};
+	json["nodes"] = Json::objectValue;
+	for (auto const& [id, node]: _graph.nodes)
+		json["nodes"][to_string(id)] = expressionToJson(node);
+	json["edges"] = Json::objectValue;
+	for (auto const& [id, successors]: _graph.edges)
+	{
+		Json::Value& edges = json["edges"][to_string(id)] = Json::arrayValue;
+		for (unsigned successor: successors)
+			edges.append(successor);
+	}
+	return json;
+}
+
+optional<CHCSolverInterface::CexGraph> QueryCache::counterexampleFromJson(Json::Value const& _json)
+{
+	if (!_json.isObject() || !_json["nodes"].isObject() || !_json["edges"].isObject())
+		return nullopt;
+
+	CHCSolverInterface::CexGraph graph;
+	try
+	{
+		for (string const& id: _json["nodes"].getMemberNames())
+		{
+			optional<Expression> node = expressionFromJson(_json["nodes"][id]);
+			if (!node)
+				return nullopt;
+			graph.nodes.emplace(static_cast<unsigned>(stoul(id)), move(*node));
+		}
+		for (string const& id: _json["edges"].getMemberNames())
+		{
+			Json::Value const& successors = _json["edges"][id];
+			if (!successors.isArray())
+				return nullopt;
+			vector<unsigned>& edges = graph.edges[static_cast<unsigned>(stoul(id))];
+			for (auto const& successor: successors)
+			{
+				if (!successor.isUInt())
+					return nullopt;
+				edges.push_back(successor.asUInt());
+			}
+		}
+	}
+	catch (exception const&)
+	{
+		return nullopt;
+	}
+	return graph;
+}
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/**
+ * Persistent cache of SMT query results, stored in a directory.
+ */
+
+#pragma once
+
+#include <libsmtutil/CHCSolverInterface.h>
+
+#include <libsolutil/JsonFileStore.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Store for the answers of SMT and Horn solvers, keyed by the text of the query
+ * and the name and version of the solver that answered it.
+ *
+ * Every entry is a JSON object in a util::JsonFileStore, so concurrent compiler processes
+ * can share a cache directory. Entries that cannot be read are treated as missing.
+ */
+class QueryCache
+{
+public:
+	explicit QueryCache(boost::filesystem::path _directory): m_store(std::move(_directory)) {}
+
+	/// @returns the result and model that @a _solver stored for @a _query or nullopt
+	/// if there is no such entry or it cannot be read.
+	std::optional<std::pair<CheckResult, Json::Value>> load(std::string const& _solver, std::string const& _query) const;
+	/// Stores the answer of @a _solver to @a _query together with its model.
+	/// Only SAT and UNSAT results are stored, since the others depend on timeouts
+	/// and resource limits. Failures are ignored.
+	void store(std::string const& _solver, std::string const& _query, CheckResult _result, Json::Value const& _model) const;
+
+	static Json::Value valuesToJson(std::vector<std::string> const& _values);
+	/// @returns the values encoded in @a _json or nullopt if it is malformed.
+	static std::optional<std::vector<std::string>> valuesFromJson(Json::Value const& _json);
+
+	static Json::Value counterexampleToJson(CHCSolverInterface::CexGraph const& _graph);
+	/// @returns the counterexample graph encoded in @a _json or nullopt if it is malformed.
+	static std::optional<CHCSolverInterface::CexGraph> counterexampleFromJson(Json::Value const& _json);
+
+private:
+	util::JsonFileStore m_store;
+};
+
+}
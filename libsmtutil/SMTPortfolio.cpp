@@ -24,8 +24,14 @@
 #ifdef HAVE_CVC4
 #include <libsmtutil/CVC4Interface.h>
 #endif
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,21 +42,44 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers,
+	shared_ptr<QueryCache> _queryCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_raceSolvers(_raceSolvers),
+	m_queryCache(move(_queryCache))
 {
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+	m_solverVersions = "smtlib2";
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
+	{
 		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solverVersions += ", " + Z3Interface::version();
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
+	{
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solverVersions += ", " + CVC4Interface::version();
+	}
 #endif
 }
 
+SMTPortfolio::SMTPortfolio(
+	vector<unique_ptr<SolverInterface>> _solvers,
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers
+):
+	SolverInterface(_queryTimeout),
+	m_solvers(move(_solvers)),
+	m_raceSolvers(_raceSolvers)
+{
+	smtAssert(!m_solvers.empty() && dynamic_cast<SMTLib2Interface*>(m_solvers.front().get()), "");
+}
+
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
@@ -111,8 +140,37 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * In racing mode, the solvers run concurrently and the answer of the first solver that
+ * answers the query is used without waiting for the others. Conflicts are not detected.
+ * If no solver answers, the result is decided as in 3).
+ *
+ * If a query cache is set, an answer that the same solvers gave to the same query before
+ * is returned without running them. The key of the cache is the SMT-LIB2 text of the query.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	string query;
+	if (m_queryCache)
+	{
+		auto smtlib2 = dynamic_cast<SMTLib2Interface*>(m_solvers.front().get());
+		smtAssert(smtlib2, "");
+		query = smtlib2->dumpQuery(_expressionsToEvaluate);
+		if (auto cached = m_queryCache->load(m_solverVersions, query))
+			if (auto values = QueryCache::valuesFromJson(cached->second))
+				return {cached->first, move(*values)};
+	}
+
+	auto result = (m_raceSolvers && m_solvers.size() > 2) ?
+		race(_expressionsToEvaluate) :
+		compare(_expressionsToEvaluate);
+
+	if (m_queryCache)
+		m_queryCache->store(m_solverVersions, query, result.first, QueryCache::valuesToJson(result.second));
+	return result;
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::compare(vector<Expression> const& _expressionsToEvaluate)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
@@ -140,6 +198,67 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
+pair<CheckResult, vector<string>> SMTPortfolio::race(vector<Expression> const& _expressionsToEvaluate)
+{
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size());
+	vector<exception_ptr> exceptions(m_solvers.size());
+	// The solvers ignore interrupts that arrive before their check has started,
+	// so only solvers that have been started are interrupted.
+	vector<bool> started(m_solvers.size(), false);
+	vector<bool> finished(m_solvers.size(), false);
+	optional<size_t> winner;
+	mutex resultMutex;
+	auto runSolver = [&](size_t _solver) {
+		{
+			lock_guard<mutex> lock(resultMutex);
+			if (winner)
+				return;
+			started[_solver] = true;
+		}
+		pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+		exception_ptr exception;
+		try
+		{
+			result = m_solvers[_solver]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			exception = current_exception();
+		}
+		lock_guard<mutex> lock(resultMutex);
+		finished[_solver] = true;
+		exceptions[_solver] = move(exception);
+		if (!winner && solverAnswered(result.first))
+		{
+			winner = _solver;
+			for (size_t other = 0; other < m_solvers.size(); ++other)
+				if (started[other] && !finished[other])
+					m_solvers[other]->interrupt();
+		}
+		results[_solver] = move(result);
+	};
+
+	// The SMT-LIB2 interface in position 0 only looks up the given responses,
+	// so it runs on this thread while the other solvers are working.
+	vector<thread> threads;
+	for (size_t solver = 1; solver < m_solvers.size(); ++solver)
+		threads.emplace_back(runSolver, solver);
+	runSolver(0);
+	for (thread& t: threads)
+		t.join();
+
+	// As when the solvers are queried one after another, errors are not hidden by answers.
+	for (exception_ptr const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+	if (winner)
+		return move(results[*winner]);
+	for (auto const& result: results)
+		if (result.first == CheckResult::UNKNOWN)
+			return {CheckResult::UNKNOWN, {}};
+	return {CheckResult::ERROR, {}};
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
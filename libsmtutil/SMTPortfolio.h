@@ -25,16 +25,23 @@
 
 #include <boost/noncopyable.hpp>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+class QueryCache;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * If @a _raceSolvers is set, the solvers instead run concurrently for each query
+ * and the first answer is used.
+ * If @a _queryCache is set, it is consulted before the solvers are queried
+ * and stores their answers.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
@@ -43,7 +50,15 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _raceSolvers = false,
+		std::shared_ptr<QueryCache> _queryCache = {}
+	);
+	/// Wraps the given solvers, the first of which has to be an SMTLib2Interface.
+	SMTPortfolio(
+		std::vector<std::unique_ptr<SolverInterface>> _solvers,
+		std::optional<unsigned> _queryTimeout,
+		bool _raceSolvers
 	);
 
 	void reset() override;
@@ -61,8 +76,17 @@ public:
 	size_t solvers() override { return m_solvers.size(); }
 private:
 	static bool solverAnswered(CheckResult result);
+	/// Queries the solvers one after another and compares their answers.
+	std::pair<CheckResult, std::vector<std::string>> compare(std::vector<Expression> const& _expressionsToEvaluate);
+	/// Runs the solvers concurrently and interrupts the others once one of them answers.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	bool m_raceSolvers = false;
+
+	std::shared_ptr<QueryCache> m_queryCache;
+	/// Names and versions of the solvers, which are part of the key of cached answers.
+	std::string m_solverVersions;
 
 	std::vector<Expression> m_assertions;
 };
@@ -18,7 +18,10 @@
 
 #include <libsmtutil/Z3CHCInterface.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
 
 #include <set>
 #include <stack>
@@ -59,11 +62,25 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
+	m_system.push_back({_expr, nullopt, m_z3Interface->declarations().size()});
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	if (m_queryCache)
+	{
+		string entry = "relation ";
+		encode(_expr, entry);
+		hashEntry(entry);
+	}
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	m_system.push_back({_expr, _name, m_z3Interface->declarations().size()});
+	if (m_queryCache)
+	{
+		string entry = "rule " + _name + " ";
+		encode(_expr, entry);
+		hashEntry(entry);
+	}
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -80,9 +97,21 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
 {
 	CheckResult result;
+	CexGraph cex;
 	try
 	{
 		z3::expr z3Expr = m_z3Interface->toZ3Expr(_expr);
+		string queryText;
+		if (m_queryCache)
+		{
+			hashEntry("");
+			queryText = m_systemHash.hex() + " query ";
+			encode(_expr, queryText);
+			if (auto cached = m_queryCache->load(solverVersion(), queryText))
+				if (auto cachedCex = QueryCache::counterexampleFromJson(cached->second))
+					return {cached->first, move(*cachedCex)};
+		}
+
 		switch (m_solver.query(z3Expr))
 		{
 		case z3::check_result::sat:
@@ -93,7 +122,7 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 			if (m_version >= tuple(4, 8, 8, 0))
 			{
 				auto proof = m_solver.get_answer();
-				return {result, cexGraph(proof)};
+				cex = cexGraph(proof);
 			}
 			break;
 		}
@@ -110,6 +139,9 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 		}
 		}
 		// TODO retrieve model / invariants
+
+		if (m_queryCache)
+			m_queryCache->store(solverVersion(), queryText, result, QueryCache::counterexampleToJson(cex));
 	}
 	catch (z3::exception const& _err)
 	{
@@ -125,7 +157,7 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 			result = CheckResult::ERROR;
 	}
 
-	return {result, {}};
+	return {result, cex};
 }
 
 void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
@@ -149,6 +181,136 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	p.set("fp.xform.inline_eager", _preProcessing);
 
 	m_solver.set(p);
+	m_preProcessing = _preProcessing;
+}
+
+unique_ptr<Z3CHCInterface> Z3CHCInterface::clone() const
+{
+	auto clone = make_unique<Z3CHCInterface>(m_queryTimeout);
+	clone->setQueryCache(m_queryCache);
+	auto const& declarations = m_z3Interface->declarations();
+	size_t declared = 0;
+	auto declareUpTo = [&](size_t _count) {
+		for (; declared < _count; ++declared)
+			clone->declareVariable(declarations[declared].first, declarations[declared].second);
+	};
+	// Rules are universally quantified over the variables declared when they were added,
+	// so declarations are replayed in their original position.
+	for (auto const& entry: m_system)
+	{
+		declareUpTo(entry.declarations);
+		if (entry.ruleName)
+			clone->addRule(entry.expr, *entry.ruleName);
+		else
+			clone->registerRelation(entry.expr);
+	}
+	declareUpTo(declarations.size());
+	return clone;
+}
+
+void Z3CHCInterface::hashEntry(string const& _entry)
+{
+	auto const& declarations = m_z3Interface->declarations();
+	string text;
+	for (; m_hashedDeclarations < declarations.size(); ++m_hashedDeclarations)
+	{
+		text += "declare " + declarations[m_hashedDeclarations].first + " ";
+		encode(declarations[m_hashedDeclarations].second, text);
+		text += "\n";
+	}
+	text += _entry;
+	if (!text.empty())
+		m_systemHash = util::keccak256(m_systemHash.asBytes() + util::asBytes(text));
+}
+
+void Z3CHCInterface::encode(Expression const& _expr, string& _output)
+{
+	// The sort is needed to tell apart literals and some operators, e.g. bv2int.
+	_output += "(" + _expr.name + " ";
+	encode(_expr.sort, _output);
+	for (auto const& argument: _expr.arguments)
+	{
+		_output += " ";
+		encode(argument, _output);
+	}
+	_output += ")";
+}
+
+void Z3CHCInterface::encode(SortPointer const& _sort, string& _output)
+{
+	smtAssert(_sort, "");
+	if (auto it = m_sortIds.find(_sort); it != m_sortIds.end())
+	{
+		_output += "#" + to_string(it->second);
+		return;
+	}
+	size_t id = m_sortIds.size();
+	m_sortIds[_sort] = id;
+	_output += "#" + to_string(id) + "=";
+	switch (_sort->kind)
+	{
+	case Kind::Int:
+		_output += dynamic_cast<IntSort const&>(*_sort).isSigned ? "sint" : "uint";
+		break;
+	case Kind::Bool:
+		_output += "bool";
+		break;
+	case Kind::BitVector:
+		_output += "bv" + to_string(dynamic_cast<BitVectorSort const&>(*_sort).size);
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(*_sort);
+		_output += "(function";
+		for (auto const& domain: functionSort.domain)
+		{
+			_output += " ";
+			encode(domain, _output);
+		}
+		_output += " ";
+		encode(functionSort.codomain, _output);
+		_output += ")";
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(*_sort);
+		_output += "(array ";
+		encode(arraySort.domain, _output);
+		_output += " ";
+		encode(arraySort.range, _output);
+		_output += ")";
+		break;
+	}
+	case Kind::Sort:
+		_output += "(sort ";
+		encode(dynamic_cast<SortSort const&>(*_sort).inner, _output);
+		_output += ")";
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(*_sort);
+		_output += "(tuple " + tupleSort.name;
+		for (size_t i = 0; i < tupleSort.members.size(); ++i)
+		{
+			_output += " (" + tupleSort.members[i] + " ";
+			encode(tupleSort.components[i], _output);
+			_output += ")";
+		}
+		_output += ")";
+		break;
+	}
+	}
+}
+
+string Z3CHCInterface::solverVersion() const
+{
+	string version = Z3Interface::version() + " spacer";
+	if (!m_preProcessing)
+		version += " without preprocessing";
+	if (m_queryTimeout)
+		version += " timeout " + to_string(*m_queryTimeout);
+	return version;
 }
 
 /**
@@ -25,6 +25,12 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -49,7 +55,23 @@ public:
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	/// @returns a new interface with its own Z3 context that contains the
+	/// same variables, relations and rules as this one.
+	/// Different interfaces can be queried concurrently.
+	std::unique_ptr<Z3CHCInterface> clone() const;
+
 private:
+	/// @returns the name and version of the solver and the options that affect its answers.
+	std::string solverVersion() const;
+
+	/// Adds @a _entry and the variables declared before it to m_systemHash.
+	/// Only used if there is a query cache.
+	void hashEntry(std::string const& _entry);
+	/// Appends a textual encoding of @a _expr to @a _output that, unlike the
+	/// output of the Z3 printer, does not depend on the Z3 version.
+	void encode(Expression const& _expr, std::string& _output);
+	void encode(SortPointer const& _sort, std::string& _output);
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -67,6 +89,26 @@ private:
 	z3::fixedpoint m_solver;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	bool m_preProcessing = true;
+
+	/// A registered relation or an added rule, in the order they were given to the solver.
+	struct SystemEntry
+	{
+		Expression expr;
+		/// Name of the rule, or nullopt if this is a relation.
+		std::optional<std::string> ruleName;
+		/// Number of variable declarations that preceded the entry.
+		size_t declarations;
+	};
+	std::vector<SystemEntry> m_system;
+
+	/// Hash of all declarations, relations and rules given to the solver, which is part
+	/// of the key of each query in the query cache. Updated as entries are added.
+	util::h256 m_systemHash;
+	size_t m_hashedDeclarations = 0;
+	/// Sorts are encoded in full once and by their number afterwards.
+	std::map<SortPointer, size_t> m_sortIds;
 };
 
 }
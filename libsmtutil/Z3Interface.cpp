@@ -38,6 +38,16 @@ bool Z3Interface::available()
 #endif
 }
 
+string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return "z3 " + to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision);
+}
+
 Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(m_context)
@@ -55,6 +65,7 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_declarations.clear();
 	m_solver.reset();
 }
 
@@ -71,6 +82,7 @@ void Z3Interface::pop()
 void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	m_declarations.emplace_back(_name, _sort);
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
@@ -31,6 +31,8 @@ public:
 	Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	static bool available();
+	/// @returns the name and version of the z3 library in use.
+	static std::string version();
 
 	void reset() override;
 
@@ -41,12 +43,15 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override { m_context.interrupt(); }
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
 	std::map<std::string, z3::expr> constants() const { return m_constants; }
 	std::map<std::string, z3::func_decl> functions() const { return m_functions; }
+	/// @returns the arguments of all calls to declareVariable since the last reset, in order.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 
 	z3::context* context() { return &m_context; }
 
@@ -67,6 +72,7 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
 };
 
 }
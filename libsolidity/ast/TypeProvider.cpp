@@ -26,22 +26,22 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
+thread_local BoolType const TypeProvider::m_boolean{};
+thread_local InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
 
 /// The string and bytes unique_ptrs are initialized when they are first used because
 /// they rely on `byte` being available which we cannot guarantee in the static init context.
-unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-unique_ptr<ArrayType> TypeProvider::m_stringMemory;
+thread_local unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
+thread_local unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
+thread_local unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
+thread_local unique_ptr<ArrayType> TypeProvider::m_stringStorage;
+thread_local unique_ptr<ArrayType> TypeProvider::m_stringMemory;
 
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
+thread_local TupleType const TypeProvider::m_emptyTuple{};
+thread_local AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
+thread_local AddressType const TypeProvider::m_address{StateMutability::NonPayable};
 
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
+thread_local array<unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
 	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
 	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
 	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
@@ -76,7 +76,7 @@ array<unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
 	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
 }};
 
-array<unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
+thread_local array<unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
 	{make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
 	{make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
 	{make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
@@ -111,7 +111,7 @@ array<unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
 	{make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
 }};
 
-array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
+thread_local array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
 	{make_unique<FixedBytesType>(1)},
 	{make_unique<FixedBytesType>(2)},
 	{make_unique<FixedBytesType>(3)},
@@ -146,7 +146,7 @@ array<unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
 	{make_unique<FixedBytesType>(32)}
 }};
 
-array<unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
+thread_local array<unique_ptr<MagicType>, 4> const TypeProvider::m_magics{{
 	{make_unique<MagicType>(MagicType::Kind::Block)},
 	{make_unique<MagicType>(MagicType::Kind::Message)},
 	{make_unique<MagicType>(MagicType::Kind::Transaction)},
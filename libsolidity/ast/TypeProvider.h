@@ -37,6 +37,9 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Every thread has its own set of types, so that independent compilations can run on different
+ * threads. Types must not be passed from one thread to another.
  */
 class TypeProvider
 {
@@ -200,33 +203,33 @@ public:
 	static MappingType const* mapping(Type const* _keyType, Type const* _valueType);
 
 private:
-	/// Global TypeProvider instance.
+	/// TypeProvider instance of the current thread.
 	static TypeProvider& instance()
 	{
-		static TypeProvider _provider;
+		static thread_local TypeProvider _provider;
 		return _provider;
 	}
 
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
 
-	static BoolType const m_boolean;
-	static InaccessibleDynamicType const m_inaccessibleDynamic;
+	static thread_local BoolType const m_boolean;
+	static thread_local InaccessibleDynamicType const m_inaccessibleDynamic;
 
 	/// These are lazy-initialized because they depend on `byte` being available.
-	static std::unique_ptr<ArrayType> m_bytesStorage;
-	static std::unique_ptr<ArrayType> m_bytesMemory;
-	static std::unique_ptr<ArrayType> m_bytesCalldata;
-	static std::unique_ptr<ArrayType> m_stringStorage;
-	static std::unique_ptr<ArrayType> m_stringMemory;
-
-	static TupleType const m_emptyTuple;
-	static AddressType const m_payableAddress;
-	static AddressType const m_address;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
-	static std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
-	static std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
-	static std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
+	static thread_local std::unique_ptr<ArrayType> m_bytesStorage;
+	static thread_local std::unique_ptr<ArrayType> m_bytesMemory;
+	static thread_local std::unique_ptr<ArrayType> m_bytesCalldata;
+	static thread_local std::unique_ptr<ArrayType> m_stringStorage;
+	static thread_local std::unique_ptr<ArrayType> m_stringMemory;
+
+	static thread_local TupleType const m_emptyTuple;
+	static thread_local AddressType const m_payableAddress;
+	static thread_local AddressType const m_address;
+	static thread_local std::array<std::unique_ptr<IntegerType>, 32> const m_intM;
+	static thread_local std::array<std::unique_ptr<IntegerType>, 32> const m_uintM;
+	static thread_local std::array<std::unique_ptr<FixedBytesType>, 32> const m_bytesM;
+	static thread_local std::array<std::unique_ptr<MagicType>, 4> const m_magics;        ///< MagicType's except MetaType
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
@@ -36,8 +36,15 @@ namespace solidity::frontend {
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	/// @param _optimiserThreads maximum number of threads used to optimise sub-assemblies.
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		size_t _optimiserThreads = 1
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_optimiserThreads(_optimiserThreads),
 		m_runtimeContext(_evmVersion, _revertStrings),
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
 	{ }
@@ -67,6 +74,7 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	size_t const m_optimiserThreads;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
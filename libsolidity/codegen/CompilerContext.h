@@ -277,8 +277,13 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step, optimising sub-assemblies on up to @a _threads threads.
+	void optimise(OptimiserSettings const& _settings, size_t _threads = 1)
+	{
+		evmasm::Assembly::OptimiserSettings asmSettings = translateOptimiserSettings(_settings);
+		asmSettings.threads = _threads;
+		m_asm->optimise(asmSettings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -31,6 +31,7 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
@@ -48,7 +49,20 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
-pair<string, string> IRGenerator::run(
+namespace
+{
+
+string const c_experimentalWarning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+}
+
+pair<string, shared_ptr<yul::Object>> IRGenerator::run(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
@@ -63,17 +77,16 @@ pair<string, string> IRGenerator::run(
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	asmStack.setOptimizedObjectCache(m_optimizedObjectCache);
+	asmStack.setThreads(m_optimiserThreads);
 	asmStack.optimize();
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+	return {c_experimentalWarning + ir, asmStack.parserResult()};
+}
 
-	return {warning + ir, warning + asmStack.print()};
+string IRGenerator::print(yul::Object const& _object, langutil::EVMVersion _evmVersion)
+{
+	return c_experimentalWarning + _object.toString(&yul::EVMDialect::strictAssemblyForEVMObjects(_evmVersion)) + "\n";
 }
 
 string IRGenerator::generate(
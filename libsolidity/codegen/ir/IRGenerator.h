@@ -27,9 +27,17 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
+#include <libyul/Object.h>
 #include <liblangutil/EVMVersion.h>
+
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+class OptimizedObjectCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -41,21 +49,28 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<yul::OptimizedObjectCache> _optimizedObjectCache = nullptr,
+		size_t _optimiserThreads = 1
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
+		m_optimizedObjectCache(std::move(_optimizedObjectCache)),
+		m_optimiserThreads(_optimiserThreads),
 		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates and returns the IR code, in unoptimized form and as an
+	/// analyzed Yul object that is optimized depending on the optimizer settings.
+	std::pair<std::string, std::shared_ptr<yul::Object>> run(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
 
+	/// @returns the pretty-printed form of a Yul object returned by @a run.
+	static std::string print(yul::Object const& _object, langutil::EVMVersion _evmVersion);
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -114,6 +129,10 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	/// Optimized sub-objects shared with the generators of other contracts, may be null.
+	std::shared_ptr<yul::OptimizedObjectCache> m_optimizedObjectCache;
+	/// Maximum number of threads used to optimize sibling sub-objects.
+	size_t const m_optimiserThreads;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
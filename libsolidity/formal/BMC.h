@@ -50,6 +50,11 @@ struct ErrorId;
 struct SourceLocation;
 }
 
+namespace solidity::smtutil
+{
+class QueryCache;
+}
+
 namespace solidity::frontend
 {
 
@@ -62,7 +67,9 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		std::optional<unsigned> timeout
+		std::optional<unsigned> timeout,
+		bool _raceSolvers = false,
+		std::shared_ptr<smtutil::QueryCache> _queryCache = {}
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTarget::Type>> _solvedTargets);
@@ -31,6 +31,7 @@
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/JobScheduler.h>
 
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -54,12 +55,16 @@ CHC::CHC(
 	[[maybe_unused]] map<util::h256, string> const& _smtlib2Responses,
 	[[maybe_unused]] ReadCallback::Callback const& _smtCallback,
 	SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _timeout
+	optional<unsigned> _timeout,
+	unsigned _threads,
+	shared_ptr<QueryCache> _queryCache
 ):
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
 	m_enabledSolvers(_enabledSolvers),
-	m_queryTimeout(_timeout)
+	m_queryTimeout(_timeout),
+	m_threads(_threads),
+	m_queryCache(move(_queryCache))
 {
 	bool usesZ3 = _enabledSolvers.z3;
 #ifdef HAVE_Z3
@@ -68,7 +73,10 @@ CHC::CHC(
 	usesZ3 = false;
 #endif
 	if (!usesZ3)
+	{
 		m_interface = make_unique<CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback, m_queryTimeout);
+		m_interface->setQueryCache(m_queryCache);
+	}
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -844,6 +852,7 @@ void CHC::resetSourceAnalysis()
 	{
 		/// z3::fixedpoint does not have a reset mechanism, so we need to create another.
 		m_interface.reset(new Z3CHCInterface(m_queryTimeout));
+		m_interface->setQueryCache(m_queryCache);
 		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
 		solAssert(z3Interface, "");
 		m_context.setSolver(z3Interface->z3Interface());
@@ -1281,44 +1290,30 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 	m_interface->addRule(_rule, _ruleName);
 }
 
-pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(CHCSolverInterface& _interface, smtutil::Expression const& _query)
 {
 	CheckResult result;
 	CHCSolverInterface::CexGraph cex;
-	tie(result, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	tie(result, cex) = _interface.query(_query);
 #ifdef HAVE_Z3
+	if (result == CheckResult::SATISFIABLE)
+	{
 		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
 		// We now disable those optimizations and check whether we can still solve the problem.
-		auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_interface);
 		solAssert(spacer, "");
 		spacer->setSpacerOptions(false);
 
 		CheckResult resultNoOpt;
 		CHCSolverInterface::CexGraph cexNoOpt;
-		tie(resultNoOpt, cexNoOpt) = m_interface->query(_query);
+		tie(resultNoOpt, cexNoOpt) = _interface.query(_query);
 
 		if (resultNoOpt == CheckResult::SATISFIABLE)
 			cex = move(cexNoOpt);
 
 		spacer->setSpacerOptions(true);
-#endif
-		break;
-	}
-	case CheckResult::UNSATISFIABLE:
-		break;
-	case CheckResult::UNKNOWN:
-		break;
-	case CheckResult::CONFLICTING:
-		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
-	case CheckResult::ERROR:
-		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
-		break;
 	}
+#endif
 	return {result, cex};
 }
 
@@ -1378,6 +1373,15 @@ void CHC::checkVerificationTargets()
 			}
 	}
 
+	// Only the integrated Horn solver can be copied into several contexts.
+	bool concurrently = m_threads > 1 && verificationTargets.size() > 1;
+#ifdef HAVE_Z3
+	concurrently = concurrently && dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+#else
+	concurrently = false;
+#endif
+	vector<CHCTargetCheck> checks;
+
 	set<unsigned> checkedErrorIds;
 	for (auto const& target: verificationTargets)
 	{
@@ -1425,9 +1429,14 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		if (concurrently)
+			checks.push_back({target, errorReporterId, errorType + " happens here.", errorType + " might happen here."});
+		else
+			checkAndReportTarget(target, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
 		checkedErrorIds.insert(target.errorId);
 	}
+	if (concurrently)
+		checkAndReportTargetsConcurrently(checks);
 
 	// There can be targets in internal functions that are not reachable from the external interface.
 	// These are safe by definition and are not even checked by the CHC engine, but this information
@@ -1461,15 +1470,33 @@ void CHC::checkAndReportTarget(
 
 	createErrorBlock();
 	connectBlocks(_target.value, error(), _target.constraints);
+	auto const& [result, model] = query(*m_interface, error());
+	reportTarget(_target, _errorReporterId, _satMsg, _unknownMsg, result, model, error().name);
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg,
+	CheckResult _result,
+	CHCSolverInterface::CexGraph const& _model,
+	string const& _root
+)
+{
 	auto const& location = _target.errorNode->location();
-	auto const& [result, model] = query(error(), location);
-	if (result == CheckResult::UNSATISFIABLE)
+	if (_result == CheckResult::CONFLICTING)
+		m_errorReporter.warning(1988_error, location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+	else if (_result == CheckResult::ERROR)
+		m_errorReporter.warning(1218_error, location, "CHC: Error trying to invoke SMT solver.");
+
+	if (_result == CheckResult::UNSATISFIABLE)
 		m_safeTargets[_target.errorNode].insert(_target.type);
-	else if (result == CheckResult::SATISFIABLE)
+	else if (_result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
 		m_unsafeTargets[_target.errorNode].insert(_target.type);
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(_model, _root);
 		if (cex)
 			m_errorReporter.warning(
 				_errorReporterId,
@@ -1491,6 +1518,88 @@ void CHC::checkAndReportTarget(
 		);
 }
 
+void CHC::checkAndReportTargetsConcurrently(vector<CHCTargetCheck> const& _checks)
+{
+#ifdef HAVE_Z3
+	auto* z3Interface = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+	solAssert(z3Interface, "");
+
+	// The sequential loop skips a target once another target with the same node and type
+	// is found unsafe. So targets are grouped by node and type, and each group is checked
+	// in order by a single solver context, which stops at the first unsafe target.
+	// Targets that are already known to be unsafe are not checked at all.
+	vector<vector<size_t>> groups;
+	map<pair<ASTNode const*, VerificationTarget::Type>, size_t> groupIndices;
+	for (size_t i = 0; i < _checks.size(); ++i)
+	{
+		auto const& target = _checks[i].target;
+		if (m_unsafeTargets.count(target.errorNode) && m_unsafeTargets.at(target.errorNode).count(target.type))
+			continue;
+		auto [it, inserted] = groupIndices.emplace(make_pair(target.errorNode, target.type), groups.size());
+		if (inserted)
+			groups.emplace_back();
+		groups[it->second].push_back(i);
+	}
+	if (groups.empty())
+		return;
+
+	// Creating predicates is not thread-safe, so the error blocks of all targets
+	// that might be queried are created before the system is copied.
+	// Each error block is stored together with the rule that leads to it.
+	map<size_t, pair<smtutil::Expression, smtutil::Expression>> errorBlocks;
+	for (auto const& group: groups)
+		for (size_t i: group)
+		{
+			auto const& target = _checks[i].target;
+			createErrorBlock();
+			errorBlocks.emplace(i, make_pair(
+				error(),
+				smtutil::Expression::implies(target.value && m_context.assertions() && target.constraints, error())
+			));
+		}
+
+	size_t threads = min<size_t>(m_threads, groups.size());
+	vector<unique_ptr<Z3CHCInterface>> clones;
+	vector<CHCSolverInterface*> interfaces{z3Interface};
+	for (size_t i = 1; i < threads; ++i)
+		interfaces.push_back(clones.emplace_back(z3Interface->clone()).get());
+
+	// Groups are assigned to solver contexts in a fixed way, so that every context
+	// sees the same sequence of queries in every run. Like in the sequential loop,
+	// the rule of an error block is only added right before it is queried.
+	vector<optional<pair<CheckResult, CHCSolverInterface::CexGraph>>> results(_checks.size());
+	vector<std::function<void()>> jobs;
+	for (size_t i = 0; i < threads; ++i)
+		jobs.emplace_back([&, i]() {
+			for (size_t g = i; g < groups.size(); g += threads)
+				for (size_t j: groups[g])
+				{
+					auto const& [errorBlock, errorRule] = errorBlocks.at(j);
+					interfaces[i]->addRule(errorRule, _checks[j].target.value.name + "_to_" + errorBlock.name);
+					results[j] = query(*interfaces[i], errorBlock);
+					if (results[j]->first == CheckResult::SATISFIABLE)
+						break;
+				}
+		});
+	runJobs(jobs, {}, threads);
+
+	for (size_t i = 0; i < _checks.size(); ++i)
+		if (results[i])
+			reportTarget(
+				_checks[i].target,
+				_checks[i].errorReporterId,
+				_checks[i].satMsg,
+				_checks[i].unknownMsg,
+				results[i]->first,
+				results[i]->second,
+				errorBlocks.at(i).first.name
+			);
+#else
+	for (auto const& check: _checks)
+		checkAndReportTarget(check.target, check.errorReporterId, check.satMsg, check.unknownMsg);
+#endif
+}
+
 /**
 The counterexample DAG has the following properties:
 1) The root node represents the reachable error predicate.
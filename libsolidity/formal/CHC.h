@@ -56,7 +56,9 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		std::optional<unsigned> timeout
+		std::optional<unsigned> timeout,
+		unsigned _threads = 1,
+		std::shared_ptr<smtutil::QueryCache> _queryCache = {}
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -197,7 +199,11 @@ private:
 	void addRule(smtutil::Expression const& _rule, std::string const& _ruleName);
 	/// @returns <true, empty> if query is unsatisfiable (safe).
 	/// @returns <false, model> otherwise.
-	std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Does not report anything, so that different interfaces can be queried concurrently.
+	static std::pair<smtutil::CheckResult, smtutil::CHCSolverInterface::CexGraph> query(
+		smtutil::CHCSolverInterface& _interface,
+		smtutil::Expression const& _query
+	);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTarget::Type _type, smtutil::Expression const& _errorCondition);
 
@@ -211,6 +217,23 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Reports the result of querying whether @a _target is reachable
+	/// from the error predicate @a _root.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		smtutil::CheckResult _result,
+		smtutil::CHCSolverInterface::CexGraph const& _model,
+		std::string const& _root
+	);
+	/// Verification target together with the messages that are reported for it.
+	struct CHCTargetCheck;
+	/// Checks all targets with up to m_threads solver contexts
+	/// and reports them in the order given.
+	/// Skips the same targets as calling checkAndReportTarget on each of them.
+	void checkAndReportTargetsConcurrently(std::vector<CHCTargetCheck> const& _checks);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -299,6 +322,14 @@ private:
 		ASTNode const* const errorNode;
 	};
 
+	struct CHCTargetCheck
+	{
+		CHCVerificationTarget target;
+		langutil::ErrorId errorReporterId;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+
 	/// Query placeholder stores information necessary to create the final query edge in the CHC system.
 	/// It is combined with the unique error id (and error type) to create a complete Verification Target.
 	struct CHCQueryPlaceholder
@@ -371,6 +402,12 @@ private:
 
 	/// SMT query timeout in seconds.
 	std::optional<unsigned> m_queryTimeout;
+
+	/// Maximum number of solver contexts used to check verification targets.
+	unsigned m_threads = 1;
+
+	/// Persistent cache of query results, if any.
+	std::shared_ptr<smtutil::QueryCache> m_queryCache;
 };
 
 }
@@ -75,6 +75,10 @@ struct ModelCheckerSettings
 {
 	ModelCheckerEngine engine = ModelCheckerEngine::All();
 	std::optional<unsigned> timeout;
+	/// Use the first answer of concurrently running solvers instead of comparing all answers.
+	bool raceSolvers = false;
+	/// Number of solver contexts the CHC engine uses to check verification targets concurrently.
+	unsigned threads = 1;
 };
 
 class ModelChecker
@@ -82,12 +86,14 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _queryCache, if set, stores the answers of the solvers across compilations.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
 		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
-		smtutil::SMTSolverChoice _enabledSolvers = smtutil::SMTSolverChoice::All()
+		smtutil::SMTSolverChoice _enabledSolvers = smtutil::SMTSolverChoice::All(),
+		std::shared_ptr<smtutil::QueryCache> _queryCache = {}
 	);
 
 	void analyze(SourceUnit const& _sources);
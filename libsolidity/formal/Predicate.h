@@ -166,7 +166,7 @@ private:
 
 	/// Maps the name of the predicate to the actual Predicate.
 	/// Used in counterexample generation.
-	static std::map<std::string, Predicate> m_predicates;
+	static thread_local std::map<std::string, Predicate> m_predicates;
 };
 
 }
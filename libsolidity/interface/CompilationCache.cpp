@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+optional<Json::Value> CompilationCache::load(util::h256 const& _key) const
+{
+	return m_store.load(_key);
+}
+
+void CompilationCache::store(util::h256 const& _key, Json::Value const& _entry) const
+{
+	m_store.store(_key, _entry);
+}
+
+Json::Value CompilationCache::linkerObjectToJson(evmasm::LinkerObject const& _object)
+{
+	Json::Value json{Json::objectValue};
+	json["bytecode"] = util::toHex(_object.bytecode);
+	json["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		json["linkReferences"][to_string(offset)] = library;
+	json["immutableReferences"] = Json::arrayValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value immutable{Json::objectValue};
+		immutable["hash"] = util::toHex(util::toBigEndian(hash));
+		immutable["name"] = reference.first;
+		immutable["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			immutable["offsets"].append(Json::UInt64(offset));
+		json["immutableReferences"].append(move(immutable));
+	}
+	return json;
+}
+
+optional<evmasm::LinkerObject> CompilationCache::linkerObjectFromJson(Json::Value const& _json)
+{
+	if (
+		!_json.isObject() ||
+		!_json["bytecode"].isString() ||
+		!_json["linkReferences"].isObject() ||
+		!_json["immutableReferences"].isArray()
+	)
+		return nullopt;
+
+	evmasm::LinkerObject object;
+	try
+	{
+		object.bytecode = util::fromHex(_json["bytecode"].asString(), util::WhenError::Throw);
+		for (string const& offset: _json["linkReferences"].getMemberNames())
+		{
+			if (!_json["linkReferences"][offset].isString())
+				return nullopt;
+			object.linkReferences[stoul(offset)] = _json["linkReferences"][offset].asString();
+		}
+		for (Json::Value const& immutable: _json["immutableReferences"])
+		{
+			if (!immutable["hash"].isString() || !immutable["name"].isString() || !immutable["offsets"].isArray())
+				return nullopt;
+			u256 hash = util::fromBigEndian<u256>(util::fromHex(immutable["hash"].asString(), util::WhenError::Throw));
+			vector<size_t> offsets;
+			for (Json::Value const& offset: immutable["offsets"])
+			{
+				if (!offset.isUInt64())
+					return nullopt;
+				offsets.push_back(static_cast<size_t>(offset.asUInt64()));
+			}
+			object.immutableReferences[hash] = make_pair(immutable["name"].asString(), move(offsets));
+		}
+	}
+	catch (exception const&)
+	{
+		return nullopt;
+	}
+	return object;
+}
@@ -0,0 +1,64 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent cache of compilation outputs, stored in a directory.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/JsonFileStore.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed store for the outputs of compiling a single contract.
+ *
+ * Every entry is a JSON object in a util::JsonFileStore, so concurrent compiler processes
+ * can share a cache directory. Entries that cannot be read are treated as missing.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_store(std::move(_directory)) {}
+
+	/// @returns the entry stored under @a _key or nullopt if there is no such entry
+	/// or it cannot be read.
+	std::optional<Json::Value> load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key, replacing any previous entry.
+	/// Failures are ignored, since the cache is only used to speed up compilation.
+	void store(util::h256 const& _key, Json::Value const& _entry) const;
+
+	static Json::Value linkerObjectToJson(evmasm::LinkerObject const& _object);
+	/// @returns the object encoded in @a _json or nullopt if it is malformed.
+	static std::optional<evmasm::LinkerObject> linkerObjectFromJson(Json::Value const& _json);
+
+private:
+	util::JsonFileStore m_store;
+};
+
+}
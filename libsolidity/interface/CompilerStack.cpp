@@ -47,6 +47,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -67,8 +68,11 @@
 
 #include <libevmasm/Exceptions.h>
 
+#include <libsmtutil/QueryCache.h>
+
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
+#include <libsolutil/JobScheduler.h>
 #include <libsolutil/JSON.h>
 
 #include <json/json.h>
@@ -84,15 +88,15 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
+static thread_local int g_compilerStackCounts = 0;
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_enabledSMTSolvers{smtutil::SMTSolverChoice::All()},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
+	// Because TypeProvider is currently a per-thread singleton API, we must ensure that
+	// no more than one entity is actually using it at a time on each thread.
 	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
 }
@@ -139,6 +143,19 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(unsigned _jobs)
+{
+	solAssert(_jobs > 0, "At least one job is required.");
+	m_parallelism = _jobs;
+}
+
+void CompilerStack::setCacheDirectory(string _directory)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set cache directory before parsing."));
+	m_cacheDirectory = move(_directory);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -217,11 +234,15 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_optimizedObjectCache.reset();
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
+		m_cacheDirectory.clear();
+		m_cachedOutputs.clear();
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
@@ -460,7 +481,10 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
+			shared_ptr<smtutil::QueryCache> queryCache;
+			if (!m_cacheDirectory.empty())
+				queryCache = make_shared<smtutil::QueryCache>(boost::filesystem::path(m_cacheDirectory) / "smt");
+			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers, queryCache);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
@@ -533,61 +557,304 @@ bool CompilerStack::compile(State _stopAfter)
 
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	// When compiling in parallel, EVM code is generated from the IR of all contracts at once,
+	// after the IR of every contract is available.
+	vector<ContractDefinition const*> contractsForEVMFromIR;
+	// Contracts created by several contracts are optimized only once as sub-objects.
+	m_optimizedObjectCache = make_shared<yul::OptimizedObjectCache>();
+	optional<CompilationCache> cache;
+	if (!m_cacheDirectory.empty())
+		cache.emplace(m_cacheDirectory);
+	// Requested contracts that were compiled and not loaded from the cache.
+	vector<ContractDefinition const*> compiledContracts;
+	// The warnings issued while compiling a contract are stored in its cache entry.
+	map<ContractDefinition const*, ErrorList> codegenWarnings;
+	// The diagnostics of all requested contracts in the order they are visited, so that
+	// the diagnostics of code generated in parallel can be reported in the same order.
+	vector<pair<ContractDefinition const*, ErrorList>> contractDiagnostics;
+	size_t codegenErrorCount = m_errorReporter.errors().size();
 
-	for (Source const* source: m_sourceOrder)
-		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
-				{
-					try
+	try
+	{
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
 					{
+						size_t errorCount = m_errorReporter.errors().size();
+						if (cache && loadFromCache(*cache, *contract))
+						{
+							contractDiagnostics.emplace_back(contract, ErrorList(m_errorReporter.errors().begin() + ptrdiff_t(errorCount), m_errorReporter.errors().end()));
+							continue;
+						}
+						compiledContracts.push_back(contract);
 						if (m_viaIR || m_generateIR || m_generateEwasm)
 							generateIR(*contract);
 						if (m_generateEvmBytecode)
 						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
+							if (m_viaIR && m_parallelism > 1)
+								contractsForEVMFromIR.push_back(contract);
+							else if (m_viaIR)
+								generateEVMFromIR({contract});
 							else
 								compileContract(*contract, otherCompilers);
 						}
 						if (m_generateEwasm)
 							generateEwasm(*contract);
+						codegenWarnings[contract] = ErrorList(m_errorReporter.errors().begin() + ptrdiff_t(errorCount), m_errorReporter.errors().end());
+						contractDiagnostics.emplace_back(contract, codegenWarnings[contract]);
 					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
-					}
+		if (!contractsForEVMFromIR.empty())
+		{
+			size_t errorCount = m_errorReporter.errors().size();
+			generateEVMFromIR(contractsForEVMFromIR);
+			// These warnings are issued at the location of the contract they belong to.
+			ErrorList unattributed;
+			for (auto const& error: ErrorList(m_errorReporter.errors().begin() + ptrdiff_t(errorCount), m_errorReporter.errors().end()))
+			{
+				SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+				auto diagnostics = find_if(contractDiagnostics.begin(), contractDiagnostics.end(), [&](auto const& _diagnostics) {
+					return location && _diagnostics.first->location().contains(*location);
+				});
+				if (diagnostics == contractDiagnostics.end())
+					unattributed.push_back(error);
+				else
+				{
+					codegenWarnings[diagnostics->first].push_back(error);
+					diagnostics->second.push_back(error);
 				}
+			}
+			// Report them after the other diagnostics of their contract, so that the order
+			// does not depend on the number of threads.
+			m_errorList.resize(codegenErrorCount);
+			for (auto const& diagnostics: contractDiagnostics)
+				m_errorList += diagnostics.second;
+			m_errorList += unattributed;
+		}
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+			return false;
+		}
+		else
+			throw;
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
+	if (cache)
+		for (ContractDefinition const* contract: compiledContracts)
+			storeInCache(*cache, *contract, codegenWarnings[contract]);
 	return true;
 }
 
+h256 CompilerStack::cacheKey(Contract const& _contract) const
+{
+	// The metadata covers the sources and settings. Every other setting that changes
+	// the outputs has to be added here. The number of threads does not change them.
+	// Source mappings and the assembly additionally depend on the indices of all sources.
+	string key = metadata(_contract);
+	for (auto const& [sourceName, index]: sourceIndices())
+		key += "\n" + to_string(index) + ":" + sourceName;
+	key += "\n";
+	key += m_generateEvmBytecode ? "evm," : "";
+	key += m_generateIR ? "ir," : "";
+	key += m_generateEwasm ? "ewasm," : "";
+	return util::keccak256(key);
+}
+
+bool CompilerStack::loadFromCache(CompilationCache const& _cache, ContractDefinition const& _contract)
+{
+	if (!_contract.canBeDeployed())
+		return false;
+	bool generatesIR = m_viaIR || m_generateIR || m_generateEwasm;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	optional<Json::Value> entry = _cache.load(cacheKey(compiledContract));
+	if (!entry || !(*entry)["warnings"].isArray())
+		return false;
+	for (auto const& warning: (*entry)["warnings"])
+		if (
+			!warning["id"].isUInt64() ||
+			!warning["message"].isString() ||
+			(warning.isMember("source") && (
+				!warning["source"].isString() ||
+				!m_sources.count(warning["source"].asString()) ||
+				!warning["start"].isInt() ||
+				!warning["end"].isInt()
+			))
+		)
+			return false;
+
+	optional<evmasm::LinkerObject> object;
+	optional<evmasm::LinkerObject> runtimeObject;
+	optional<evmasm::LinkerObject> ewasmObject;
+	if (m_generateEvmBytecode)
+	{
+		object = CompilationCache::linkerObjectFromJson((*entry)["bytecode"]);
+		runtimeObject = CompilationCache::linkerObjectFromJson((*entry)["deployedBytecode"]);
+		if (!object || !runtimeObject)
+			return false;
+		if (m_cachedOutputs.count(CachedOutput::Assembly) && !(*entry)["assembly"].isString())
+			return false;
+		if (m_cachedOutputs.count(CachedOutput::LegacyAssembly) && !(*entry)["legacyAssembly"].isObject())
+			return false;
+		if (m_cachedOutputs.count(CachedOutput::GasEstimates) && !(*entry)["gasEstimates"].isObject())
+			return false;
+		if (
+			m_cachedOutputs.count(CachedOutput::GeneratedSources) &&
+			(!(*entry)["generatedSources"].isArray() || !(*entry)["deployedGeneratedSources"].isArray())
+		)
+			return false;
+	}
+	if (generatesIR && (!(*entry)["ir"].isString() || !(*entry)["irOptimized"].isString()))
+		return false;
+	if (m_generateEwasm)
+	{
+		ewasmObject = CompilationCache::linkerObjectFromJson((*entry)["ewasm"]["wasm"]);
+		if (!ewasmObject || !(*entry)["ewasm"]["wast"].isString())
+			return false;
+	}
+
+	if (m_generateEvmBytecode)
+	{
+		compiledContract.object = move(*object);
+		compiledContract.runtimeObject = move(*runtimeObject);
+		if ((*entry)["sourceMap"].isString())
+			compiledContract.sourceMapping.emplace((*entry)["sourceMap"].asString());
+		if ((*entry)["deployedSourceMap"].isString())
+			compiledContract.runtimeSourceMapping.emplace((*entry)["deployedSourceMap"].asString());
+		compiledContract.generatedSources.init([&]{ return (*entry)["generatedSources"]; });
+		compiledContract.runtimeGeneratedSources.init([&]{ return (*entry)["deployedGeneratedSources"]; });
+	}
+	if (generatesIR)
+	{
+		compiledContract.yulIR = (*entry)["ir"].asString();
+		compiledContract.yulIROptimized.init([&]{ return (*entry)["irOptimized"].asString(); });
+	}
+	if (m_generateEwasm)
+	{
+		compiledContract.ewasm = (*entry)["ewasm"]["wast"].asString();
+		compiledContract.ewasmObject = move(*ewasmObject);
+	}
+
+	for (auto const& warning: (*entry)["warnings"])
+	{
+		ErrorId errorId{warning["id"].asUInt64()};
+		string const& message = warning["message"].asString();
+		SourceLocation location;
+		if (warning.isMember("source"))
+			location = SourceLocation{
+				warning["start"].asInt(),
+				warning["end"].asInt(),
+				m_sources.at(warning["source"].asString()).scanner->charStream()
+			};
+		// A warning about a contract that is not requested is stored with every contract
+		// whose compilation issued it, but has to be reported only once.
+		bool reported = any_of(m_errorReporter.errors().begin(), m_errorReporter.errors().end(), [&](auto const& _error) {
+			SourceLocation const* errorLocation = boost::get_error_info<errinfo_sourceLocation>(*_error);
+			return
+				_error->errorId() == errorId &&
+				_error->comment() &&
+				*_error->comment() == message &&
+				(errorLocation ? *errorLocation : SourceLocation{}) == location;
+		});
+		if (!reported)
+			m_errorReporter.warning(errorId, location, message);
+	}
+	compiledContract.cachedOutputs = make_shared<Json::Value const>(move(*entry));
+	return true;
+}
+
+void CompilerStack::storeInCache(
+	CompilationCache const& _cache,
+	ContractDefinition const& _contract,
+	ErrorList const& _warnings
+) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "");
+	if (!_contract.canBeDeployed())
+		return;
+
+	string const& name = _contract.fullyQualifiedName();
+	Contract const& compiledContract = contract(name);
+	Json::Value entry{Json::objectValue};
+	entry["warnings"] = Json::arrayValue;
+	for (auto const& warning: _warnings)
+	{
+		solAssert(warning->type() == Error::Type::Warning, "");
+		Json::Value cachedWarning{Json::objectValue};
+		cachedWarning["id"] = Json::UInt64(warning->errorId().error);
+		cachedWarning["message"] = warning->comment() ? *warning->comment() : string();
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*warning);
+		if (location && location->source)
+		{
+			cachedWarning["source"] = location->source->name();
+			cachedWarning["start"] = location->start;
+			cachedWarning["end"] = location->end;
+		}
+		entry["warnings"].append(move(cachedWarning));
+	}
+	if (m_generateEvmBytecode)
+	{
+		entry["bytecode"] = CompilationCache::linkerObjectToJson(compiledContract.object);
+		entry["deployedBytecode"] = CompilationCache::linkerObjectToJson(compiledContract.runtimeObject);
+		if (string const* map = sourceMapping(name))
+			entry["sourceMap"] = *map;
+		if (string const* map = runtimeSourceMapping(name))
+			entry["deployedSourceMap"] = *map;
+		// The other outputs are expensive and only computed if they are requested.
+		if (m_cachedOutputs.count(CachedOutput::Assembly))
+		{
+			StringMap sourceCodes;
+			for (auto const& [sourceName, source]: m_sources)
+				sourceCodes[sourceName] = source.scanner->source();
+			entry["assembly"] = assemblyString(name, move(sourceCodes));
+		}
+		if (m_cachedOutputs.count(CachedOutput::LegacyAssembly))
+			entry["legacyAssembly"] = assemblyJSON(name);
+		if (m_cachedOutputs.count(CachedOutput::GasEstimates))
+			entry["gasEstimates"] = gasEstimates(name);
+		if (m_cachedOutputs.count(CachedOutput::GeneratedSources))
+		{
+			entry["generatedSources"] = generatedSources(name, false);
+			entry["deployedGeneratedSources"] = generatedSources(name, true);
+		}
+	}
+	if (m_viaIR || m_generateIR || m_generateEwasm)
+	{
+		entry["ir"] = compiledContract.yulIR;
+		entry["irOptimized"] = yulIROptimized(name);
+	}
+	if (m_generateEwasm)
+	{
+		entry["ewasm"]["wast"] = compiledContract.ewasm;
+		entry["ewasm"]["wasm"] = CompilationCache::linkerObjectToJson(compiledContract.ewasmObject);
+	}
+	_cache.store(cacheKey(compiledContract), entry);
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -748,7 +1015,12 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	return contract(_contractName).yulIROptimized;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimized.init([&]{
+		if (!compiledContract.yulIROptimizedObject)
+			return string();
+		return IRGenerator::print(*compiledContract.yulIROptimizedObject, m_evmVersion);
+	});
 }
 
 string const& CompilerStack::ewasm(string const& _contractName) const
@@ -792,6 +1064,8 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyString(_sourceCodes);
+	else if (currentContract.cachedOutputs)
+		return (*currentContract.cachedOutputs)["assembly"].asString();
 	else
 		return string();
 }
@@ -805,6 +1079,8 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyJSON(sourceIndices());
+	else if (currentContract.cachedOutputs)
+		return (*currentContract.cachedOutputs)["legacyAssembly"];
 	else
 		return Json::Value();
 }
@@ -1185,7 +1461,7 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_parallelism);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
@@ -1225,21 +1501,10 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
-	// Throw a warning if EIP-170 limits are exceeded:
-	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
-	//   contract creation fails with an out of gas error.
-	if (
-		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
-	)
-		m_errorReporter.warning(
-			5574_error,
-			_contract.location(),
-			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
-			"This contract may not be deployable on mainnet. "
-			"Consider enabling the optimizer (with a low \"runs\" value!), "
-			"turning off revert strings, or using libraries."
-		);
+	// A contract loaded from the cache is compiled again if it is created by another contract,
+	// but its warnings were already reported when it was loaded.
+	if (!compiledContract.cachedOutputs)
+		checkCodeSize(_contract, compiledContract.runtimeObject);
 
 	_otherCompilers[compiledContract.contract] = compiler;
 }
@@ -1273,50 +1538,62 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, m_optimizedObjectCache, m_parallelism);
+	tie(compiledContract.yulIR, compiledContract.yulIROptimizedObject) = generator.run(_contract, otherYulSources);
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(vector<ContractDefinition const*> const& _contracts)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called generateEVMFromIR with errors."));
 
-	if (!_contract.canBeDeployed())
-		return;
-
-	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
-	if (!compiledContract.object.bytecode.empty())
-		return;
-
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
+	vector<ContractDefinition const*> contracts;
+	vector<Contract*> compiledContracts;
+	map<ContractDefinition const*, size_t> contractIndices;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		if (!contract->canBeDeployed())
+			continue;
+		Contract& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+		solAssert(compiledContract.yulIROptimizedObject, "");
+		if (!compiledContract.object.bytecode.empty() || contractIndices.count(contract))
+			continue;
+		contractIndices[contract] = contracts.size();
+		contracts.push_back(contract);
+		compiledContracts.push_back(&compiledContract);
+	}
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	// Contracts are scheduled after the contracts they create, in the same order
+	// as in the sequential pipeline.
+	vector<set<size_t>> dependencies(contracts.size());
+	vector<function<void()>> jobs;
+	for (size_t i = 0; i < contracts.size(); ++i)
+	{
+		for (ContractDefinition const* dependency: contracts[i]->annotation().contractDependencies)
+			if (contractIndices.count(dependency))
+				dependencies[i].insert(contractIndices.at(dependency));
+		jobs.emplace_back([this, compiledContract = compiledContracts[i]]() {
+			compileIRToEVM(*compiledContract);
+		});
+	}
+	util::runJobs(jobs, dependencies, m_parallelism);
 
-	// TODO: support passing metadata
-	// TODO: use stack.assemble here!
-	yul::MachineAssemblyObject init;
-	yul::MachineAssemblyObject runtime;
-	std::tie(init, runtime) = stack.assembleAndGuessRuntime();
-	compiledContract.object = std::move(*init.bytecode);
-	compiledContract.runtimeObject = std::move(*runtime.bytecode);
-	// TODO: refactor assemblyItems, runtimeAssemblyItems, generatedSources,
-	//       assemblyString, assemblyJSON, and functionEntryPoints to work with this code path
+	for (size_t i = 0; i < contracts.size(); ++i)
+		checkCodeSize(*contracts[i], compiledContracts[i]->runtimeObject);
+}
 
+void CompilerStack::checkCodeSize(ContractDefinition const& _contract, evmasm::LinkerObject const& _runtimeObject)
+{
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
 	//   contract creation fails with an out of gas error.
 	if (
 		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
+		_runtimeObject.bytecode.size() > 0x6000
 	)
 		m_errorReporter.warning(
-			9609_error,
+			m_viaIR ? 9609_error : 5574_error,
 			_contract.location(),
 			"Contract code size exceeds 24576 bytes (a limit introduced in Spurious Dragon). "
 			"This contract may not be deployable on mainnet. "
@@ -1325,6 +1602,30 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		);
 }
 
+void CompilerStack::compileIRToEVM(Contract& _compiledContract) const
+{
+	// The IR has already been parsed and optimized during its generation. Its code is
+	// optimized a second time, which can still change it. The object is copied instead
+	// of printed and parsed again, which results in the same code.
+	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	stack.setOptimizedObjectCache(m_optimizedObjectCache);
+	bool analysisSuccessful = stack.analyzeCopy(*_compiledContract.yulIROptimizedObject);
+	solAssert(analysisSuccessful, "");
+	stack.optimize();
+
+	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+
+	// TODO: support passing metadata
+	// TODO: use stack.assemble here!
+	yul::MachineAssemblyObject init;
+	yul::MachineAssemblyObject runtime;
+	std::tie(init, runtime) = stack.assembleAndGuessRuntime();
+	_compiledContract.object = std::move(*init.bytecode);
+	_compiledContract.runtimeObject = std::move(*runtime.bytecode);
+	// TODO: refactor assemblyItems, runtimeAssemblyItems, generatedSources,
+	//       assemblyString, assemblyJSON, and functionEntryPoints to work with this code path
+}
+
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1335,13 +1636,14 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(compiledContract.yulIROptimizedObject, "");
 	if (!compiledContract.ewasm.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
+	// The optimization and translation modify the object, so a copy is used.
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	bool analysisSuccessful = stack.analyzeCopy(*compiledContract.yulIROptimizedObject);
+	solAssert(analysisSuccessful, "");
 
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
@@ -1456,6 +1758,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (m_optimiserSettings.optimizeFunctionsSeparately)
+				details["yulDetails"]["separateFunctions"] = true;
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1622,7 +1926,12 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	if (!assemblyItems(_contractName) && !runtimeAssemblyItems(_contractName))
+	{
+		Contract const& currentContract = contract(_contractName);
+		if (currentContract.cachedOutputs)
+			return (*currentContract.cachedOutputs)["gasEstimates"];
 		return Json::Value();
+	}
 
 	using Gas = GasEstimator::GasConsumption;
 	GasEstimator gasEstimator(m_evmVersion);
@@ -66,6 +66,12 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+class OptimizedObjectCache;
+struct Object;
+}
+
 namespace solidity::frontend
 {
 
@@ -75,6 +81,7 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class CompilationCache;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
@@ -104,6 +111,15 @@ public:
 		None
 	};
 
+	/// Outputs that are only computed on request and stored in the compilation cache
+	/// in addition to the code, see setCachedOutputs.
+	enum class CachedOutput {
+		Assembly,
+		LegacyAssembly,
+		GasEstimates,
+		GeneratedSources
+	};
+
 	struct Remapping
 	{
 		std::string context;
@@ -166,6 +182,24 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to generate code for independent contracts.
+	/// Currently, only the EVM code generation from optimized IR and the optimisation
+	/// of independent sub-assemblies by the legacy optimizer run in parallel.
+	/// The output does not depend on this setting.
+	void setParallelism(unsigned _jobs);
+
+	/// Sets the directory used to cache the compilation outputs of contracts between runs.
+	/// Contracts whose metadata matches a cached entry are not compiled again.
+	/// Function entry points are not available for such contracts.
+	/// An empty path disables the cache.
+	/// Must be set before parsing.
+	void setCacheDirectory(std::string _directory);
+
+	/// Sets the outputs besides the code that are stored in the compilation cache.
+	/// A contract is only loaded from the cache if its entry contains all of them.
+	/// The other outputs in CachedOutput are not available for such contracts.
+	void setCachedOutputs(std::set<CachedOutput> _outputs) { m_cachedOutputs = std::move(_outputs); }
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -363,7 +397,8 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		std::shared_ptr<yul::Object> yulIROptimizedObject; ///< Optimized and analyzed experimental Yul IR.
+		util::LazyInit<std::string const> yulIROptimized; ///< Optimized experimental Yul IR code.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -375,6 +410,8 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// Outputs loaded from the compilation cache, if the contract was not compiled.
+		std::shared_ptr<Json::Value const> cachedOutputs;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -405,14 +442,40 @@ private:
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
 
-	/// Generate EVM representation for a single contract.
+	/// Generate EVM representation for the given contracts, using up to
+	/// m_parallelism threads.
 	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	void generateEVMFromIR(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Compiles the optimized IR of a single contract to EVM bytecode.
+	/// Only modifies @a _compiledContract and does not report errors, so that it
+	/// can run concurrently for different contracts.
+	void compileIRToEVM(Contract& _compiledContract) const;
 
 	/// Generate Ewasm representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEwasm(ContractDefinition const& _contract);
 
+	/// Warns if @a _runtimeObject of @a _contract exceeds the EIP-170 code size limit.
+	void checkCodeSize(ContractDefinition const& _contract, evmasm::LinkerObject const& _runtimeObject);
+
+	/// @returns the key of @a _contract in the compilation cache, which covers all inputs
+	/// that influence its compilation outputs.
+	util::h256 cacheKey(Contract const& _contract) const;
+
+	/// Loads the outputs of @a _contract from @a _cache and reports the warnings stored with them.
+	/// @returns false if there is no usable entry, in which case nothing is modified.
+	bool loadFromCache(CompilationCache const& _cache, ContractDefinition const& _contract);
+
+	/// Stores the outputs of @a _contract in @a _cache, together with the warnings
+	/// @a _warnings that code generation issued for it.
+	/// Can only be called after state is CompilationSuccessful.
+	void storeInCache(
+		CompilationCache const& _cache,
+		ContractDefinition const& _contract,
+		langutil::ErrorList const& _warnings
+	) const;
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -467,6 +530,9 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	unsigned m_parallelism = 1;
+	std::string m_cacheDirectory;
+	std::set<CachedOutput> m_cachedOutputs;
 	langutil::EVMVersion m_evmVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	smtutil::SMTSolverChoice m_enabledSMTSolvers;
@@ -486,6 +552,8 @@ private:
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Optimized Yul sub-objects shared between the contracts of a single compilation.
+	std::shared_ptr<yul::OptimizedObjectCache> m_optimizedObjectCache;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
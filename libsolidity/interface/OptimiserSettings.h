@@ -95,6 +95,7 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
+			optimizeFunctionsSeparately == _other.optimizeFunctionsSeparately &&
 			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
 	}
 
@@ -121,6 +122,10 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// Run the Yul optimiser steps that only look at one function on each function separately,
+	/// so that they can use several threads. This changes the names of some introduced variables,
+	/// but the result does not depend on the number of threads.
+	bool optimizeFunctionsSeparately = false;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
@@ -322,6 +322,30 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns the outputs besides the code that are requested for any contract
+/// and have to be stored in the compilation cache.
+set<CompilerStack::CachedOutput> cachedOutputs(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return {};
+
+	static map<string, CompilerStack::CachedOutput> const outputs{
+		{"evm.assembly", CompilerStack::CachedOutput::Assembly},
+		{"evm.legacyAssembly", CompilerStack::CachedOutput::LegacyAssembly},
+		{"evm.gasEstimates", CompilerStack::CachedOutput::GasEstimates},
+		{"evm.bytecode.generatedSources", CompilerStack::CachedOutput::GeneratedSources},
+		{"evm.deployedBytecode.generatedSources", CompilerStack::CachedOutput::GeneratedSources}
+	};
+
+	set<CompilerStack::CachedOutput> ret;
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& [artifact, output]: outputs)
+				if (isArtifactRequested(requests, artifact, false))
+					ret.insert(output);
+	return ret;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -428,13 +452,13 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"engine", "timeout"};
+	static set<string> keys{"engine", "raceSolvers", "threads", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -598,12 +622,14 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "separateFunctions"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "separateFunctions", settings.optimizeFunctionsSeparately))
+				return *error;
 		}
 	}
 	return { std::move(settings) };
@@ -770,6 +796,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive unsigned number.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -915,6 +948,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		if (!modelCheckerSettings["raceSolvers"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.raceSolvers must be a Boolean.");
+		ret.modelCheckerSettings.raceSolvers = modelCheckerSettings["raceSolvers"].asBool();
+	}
+
+	if (modelCheckerSettings.isMember("threads"))
+	{
+		if (!modelCheckerSettings["threads"].isUInt() || modelCheckerSettings["threads"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.modelChecker.threads must be a positive integer.");
+		ret.modelCheckerSettings.threads = modelCheckerSettings["threads"].asUInt();
+	}
+
 	return { std::move(ret) };
 }
 
@@ -927,6 +974,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setCacheDirectory(m_cacheDirectory);
+	compilerStack.setCachedOutputs(cachedOutputs(_inputsAndSettings.outputSelection));
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
@@ -1308,7 +1358,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// Resets the repository unless another compilation of the same generation is running concurrently.
+	YulStringRepository::CompilationScope yulStringScope;
 
 	try
 	{
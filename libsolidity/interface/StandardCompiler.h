@@ -54,6 +54,11 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Sets the directory used to cache compilation outputs between runs, see
+	/// CompilerStack::setCacheDirectory. The input cannot choose this directory,
+	/// because the compiler writes to it.
+	void setCacheDirectory(std::string _directory) { m_cacheDirectory = std::move(_directory); }
+
 private:
 	struct InputsAndSettings
 	{
@@ -73,6 +78,7 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		unsigned parallelism = 1;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
@@ -83,6 +89,7 @@ private:
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::string m_cacheDirectory;
 };
 
 }
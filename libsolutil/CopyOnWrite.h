@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace solidity::util
+{
+
+/// A value that is shared between copies until one of them is modified.
+/// Copying is O(1). The first call to mutate() on a shared value copies it, so that the
+/// other copies are not affected.
+/// Copies are not synchronised: all copies of a value have to be used from the same thread.
+/// \tparam T the type of the stored value
+template<typename T>
+class CopyOnWrite
+{
+public:
+	/// Initializes the class to hold a default-constructed value.
+	CopyOnWrite(): m_value(std::make_shared<T>()) {}
+	explicit CopyOnWrite(T _value): m_value(std::make_shared<T>(std::move(_value))) {}
+
+	T const& operator*() const { return *m_value; }
+	T const* operator->() const { return m_value.get(); }
+
+	/// @returns a reference to the value that can be modified, copying it first if it is
+	/// shared with other instances. The reference is invalidated by copying `*this`.
+	T& mutate()
+	{
+		if (m_value.use_count() > 1)
+			m_value = std::make_shared<T>(*m_value);
+		return *m_value;
+	}
+
+	/// @returns true if the value is shared with @a _other, which implies that they are equal.
+	bool sharesValueWith(CopyOnWrite const& _other) const { return m_value == _other.m_value; }
+
+	bool operator==(CopyOnWrite const& _other) const
+	{
+		return sharesValueWith(_other) || *m_value == *_other.m_value;
+	}
+	bool operator!=(CopyOnWrite const& _other) const { return !(*this == _other); }
+
+private:
+	std::shared_ptr<T> m_value;
+};
+
+}
@@ -0,0 +1,223 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/JobScheduler.h>
+
+#include <libsolutil/Assertions.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <system_error>
+#include <thread>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+enum class JobState { Waiting, Ready, Running, Finished, Skipped };
+
+/// Shared state of the worker threads of a single @a runJobs call.
+class JobQueue
+{
+public:
+	JobQueue(
+		vector<function<void()>> const& _jobs,
+		vector<set<size_t>> const& _dependencies,
+		vector<size_t> const& _sequentialOrder
+	):
+		m_jobs(_jobs),
+		m_position(_jobs.size()),
+		m_state(_jobs.size(), JobState::Waiting),
+		m_missingDependencies(_jobs.size(), 0),
+		m_dependants(_jobs.size()),
+		m_exceptions(_jobs.size())
+	{
+		for (size_t position = 0; position < _sequentialOrder.size(); ++position)
+			m_position[_sequentialOrder[position]] = position;
+		for (size_t job = 0; job < _dependencies.size(); ++job)
+		{
+			m_missingDependencies[job] = _dependencies[job].size();
+			for (size_t dependency: _dependencies[job])
+				m_dependants[dependency].push_back(job);
+		}
+		for (size_t job = 0; job < m_jobs.size(); ++job)
+			if (m_missingDependencies[job] == 0)
+				markReady(job);
+	}
+
+	/// Processes jobs until none are left.
+	void work()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		while (true)
+		{
+			m_condition.wait(lock, [&] { return !m_ready.empty() || m_done == m_jobs.size(); });
+			if (m_ready.empty())
+				return;
+
+			size_t job = m_ready.begin()->second;
+			m_ready.erase(m_ready.begin());
+			m_state[job] = JobState::Running;
+
+			lock.unlock();
+			exception_ptr exception;
+			try
+			{
+				m_jobs[job]();
+			}
+			catch (...)
+			{
+				exception = current_exception();
+			}
+			lock.lock();
+
+			m_state[job] = JobState::Finished;
+			++m_done;
+			if (exception)
+			{
+				m_exceptions[job] = move(exception);
+				skipDependants(job);
+			}
+			else
+				for (size_t dependant: m_dependants[job])
+					if (--m_missingDependencies[dependant] == 0 && m_state[dependant] == JobState::Waiting)
+						markReady(dependant);
+			m_condition.notify_all();
+		}
+	}
+
+	/// Rethrows the exception of the failed job that comes first in sequential order, if any.
+	void rethrowFirstException() const
+	{
+		optional<size_t> firstFailed;
+		for (size_t job = 0; job < m_jobs.size(); ++job)
+			if (m_exceptions[job] && (!firstFailed || m_position[job] < m_position[*firstFailed]))
+				firstFailed = job;
+		if (firstFailed)
+			rethrow_exception(m_exceptions[*firstFailed]);
+	}
+
+private:
+	void markReady(size_t _job)
+	{
+		m_state[_job] = JobState::Ready;
+		m_ready.emplace(m_position[_job], _job);
+	}
+
+	void skipDependants(size_t _job)
+	{
+		for (size_t dependant: m_dependants[_job])
+			if (m_state[dependant] == JobState::Waiting)
+			{
+				m_state[dependant] = JobState::Skipped;
+				++m_done;
+				skipDependants(dependant);
+			}
+	}
+
+	vector<function<void()>> const& m_jobs;
+	/// Position of each job in the sequential order.
+	vector<size_t> m_position;
+	vector<JobState> m_state;
+	vector<size_t> m_missingDependencies;
+	vector<vector<size_t>> m_dependants;
+	vector<exception_ptr> m_exceptions;
+	/// Jobs whose dependencies have finished, keyed by their position in the sequential order.
+	set<pair<size_t, size_t>> m_ready;
+	/// Number of jobs that finished or were skipped.
+	size_t m_done = 0;
+	mutex m_mutex;
+	condition_variable m_condition;
+};
+
+}
+
+vector<size_t> solidity::util::sequentialJobOrder(vector<set<size_t>> const& _dependencies)
+{
+	enum class Visit { None, InProgress, Done };
+	vector<Visit> visited(_dependencies.size(), Visit::None);
+	vector<size_t> order;
+	order.reserve(_dependencies.size());
+
+	function<void(size_t)> visit = [&](size_t _job)
+	{
+		assertThrow(_job < _dependencies.size(), InvalidJobDependencies, "Dependency on unknown job.");
+		assertThrow(visited[_job] != Visit::InProgress, InvalidJobDependencies, "Cyclic job dependencies.");
+		if (visited[_job] == Visit::Done)
+			return;
+		visited[_job] = Visit::InProgress;
+		for (size_t dependency: _dependencies[_job])
+			visit(dependency);
+		visited[_job] = Visit::Done;
+		order.push_back(_job);
+	};
+	for (size_t job = 0; job < _dependencies.size(); ++job)
+		visit(job);
+
+	return order;
+}
+
+void solidity::util::runJobs(
+	vector<function<void()>> const& _jobs,
+	vector<set<size_t>> const& _dependencies,
+	size_t _threads
+)
+{
+	assertThrow(
+		_dependencies.empty() || _dependencies.size() == _jobs.size(),
+		InvalidJobDependencies,
+		"Dependencies do not match the jobs."
+	);
+	vector<size_t> order(_jobs.size());
+	if (_dependencies.empty())
+		iota(order.begin(), order.end(), 0);
+	else
+		order = sequentialJobOrder(_dependencies);
+
+	if (_threads <= 1 || _jobs.size() <= 1)
+	{
+		for (size_t job: order)
+			_jobs[job]();
+		return;
+	}
+
+	JobQueue queue(_jobs, _dependencies, order);
+	vector<thread> workers;
+	for (size_t i = 1; i < min(_threads, _jobs.size()); ++i)
+		try
+		{
+			workers.emplace_back([&] { queue.work(); });
+		}
+		catch (system_error const&)
+		{
+			// Continue with the threads we have (e.g. on platforms without thread support).
+			break;
+		}
+	queue.work();
+	for (thread& worker: workers)
+		worker.join();
+
+	queue.rethrowFirstException();
+}
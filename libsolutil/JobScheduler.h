@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Execution of interdependent jobs on a pool of worker threads.
+ */
+
+#pragma once
+
+#include <libsolutil/Exceptions.h>
+
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace solidity::util
+{
+
+DEV_SIMPLE_EXCEPTION(InvalidJobDependencies);
+
+/// @returns the order in which @a runJobs executes jobs on a single thread:
+/// Jobs are visited by ascending index and every job is preceded by its (transitive) dependencies.
+/// @param _dependencies contains, for each job, the indices of the jobs it depends on.
+/// Throws InvalidJobDependencies if the dependency graph has a cycle or refers to unknown jobs.
+std::vector<size_t> sequentialJobOrder(std::vector<std::set<size_t>> const& _dependencies);
+
+/// Runs all @a _jobs, using up to @a _threads threads, including the calling one.
+/// A job is only started after all jobs listed in @a _dependencies for it have finished
+/// successfully. An empty @a _dependencies means that the jobs are independent.
+///
+/// If @a _threads is at most one, the jobs are run on the calling thread in the order given
+/// by @a sequentialJobOrder and the first exception is propagated immediately.
+/// Otherwise, a job that throws prevents only its (transitive) dependants from being run.
+/// Once all other jobs have finished, the exception of the failed job that comes first in
+/// sequential order is rethrown. This is the exception a sequential run would have thrown,
+/// so the outcome does not depend on the number of threads, provided the jobs themselves
+/// only write to disjoint state.
+void runJobs(
+	std::vector<std::function<void()>> const& _jobs,
+	std::vector<std::set<size_t>> const& _dependencies,
+	size_t _threads
+);
+
+}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/JsonFileStore.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <random>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+optional<Json::Value> JsonFileStore::load(h256 const& _key) const
+{
+	fs::path filePath = path(_key);
+	boost::system::error_code error;
+	if (!fs::is_regular_file(filePath, error))
+		return nullopt;
+
+	string content;
+	try
+	{
+		content = readFileAsString(filePath.string());
+	}
+	catch (Exception const&)
+	{
+		return nullopt;
+	}
+	Json::Value object;
+	if (
+		!jsonParseStrict(content, object) ||
+		!object.isObject() ||
+		object["key"] != toHex(_key.asBytes())
+	)
+		return nullopt;
+	return object;
+}
+
+void JsonFileStore::store(h256 const& _key, Json::Value _object) const
+{
+	_object["key"] = toHex(_key.asBytes());
+
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a file with a unique name first, so that readers never see partial objects.
+	fs::path filePath = path(_key);
+	fs::path temporaryPath = filePath;
+	temporaryPath += "." + to_string(random_device{}()) + ".tmp";
+	{
+		fs::ofstream file(temporaryPath, ios::binary | ios::trunc);
+		file << jsonCompactPrint(_object);
+		if (!file)
+		{
+			file.close();
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, filePath, error);
+	if (error)
+		fs::remove(temporaryPath, error);
+}
+
+fs::path JsonFileStore::path(h256 const& _key) const
+{
+	return m_directory / (toHex(_key.asBytes()) + ".json");
+}
@@ -0,0 +1,61 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Store of JSON objects in a directory that can be shared between processes.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+
+namespace solidity::util
+{
+
+/**
+ * Content-addressed store of JSON objects, one file per object, named after its key.
+ *
+ * Objects are written to a file with a unique name first and then renamed, so that
+ * concurrent processes sharing the directory never read partially written objects.
+ * Objects that cannot be read are treated as missing.
+ */
+class JsonFileStore
+{
+public:
+	explicit JsonFileStore(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the object stored under @a _key or nullopt if there is no such object
+	/// or it cannot be read.
+	std::optional<Json::Value> load(h256 const& _key) const;
+	/// Stores @a _object under @a _key, replacing any previous object.
+	/// The key is added to the object as the member "key".
+	/// Failures are ignored, since stores are only used as caches.
+	void store(h256 const& _key, Json::Value _object) const;
+
+private:
+	boost::filesystem::path path(h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -27,6 +27,7 @@
 #include <libsolutil/Assertions.h>
 
 #include <regex>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
@@ -68,14 +69,20 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template.size());
+	render(*parse(m_template), m_parameters, m_conditions, m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
+	// Same characters as in paramRegex(), but checked without a regular expression,
+	// since this is called for every parameter.
+	static string const validCharacters =
+		"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_$-";
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && _parameter.find_first_not_of(validCharacters) == string::npos,
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -100,101 +107,155 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 	);
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+struct Whiskers::ParsedTemplate
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	enum class Kind { Text, Tag, List, Condition };
+	struct Part
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+		Kind kind;
+		/// The literal text or the name of the parameter.
+		string value;
+		/// The list body or the body used if the condition is true.
+		shared_ptr<ParsedTemplate const> body;
+		/// The body used if the condition is false.
+		shared_ptr<ParsedTemplate const> elseBody;
+	};
+
+	/// The unparsed template, used for error messages.
+	string source;
+	vector<Part> parts;
+};
+
+shared_ptr<Whiskers::ParsedTemplate const> Whiskers::parse(string const& _template)
+{
+	// Every thread has its own cache, so that rendering does not need a lock.
+	thread_local unordered_map<string, shared_ptr<ParsedTemplate const>> cache;
+	// Templates are almost always string literals, but limit the cache in case they are not.
+	static size_t const maxCacheSize = 10000;
+
+	auto it = cache.find(_template);
+	if (it != cache.end())
+		return it->second;
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	return cache.emplace(_template, parseUncached(_template)).first->second;
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+shared_ptr<Whiskers::ParsedTemplate const> Whiskers::parseUncached(string const& _template)
 {
-	static regex listOrTag(
+	static regex const listOrTag(
 		"<(" + paramRegex() + ")>|"
 		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
 		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
 	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
+	using Kind = ParsedTemplate::Kind;
+
+	auto parsed = make_shared<ParsedTemplate>();
+	parsed->source = _template;
+	auto addText = [&](string::const_iterator _begin, string::const_iterator _end) {
+		if (_begin != _end)
+			parsed->parts.push_back({Kind::Text, string(_begin, _end), nullptr, nullptr});
+	};
+
+	string::const_iterator lastMatchedPos = _template.cbegin();
+	for (
+		sregex_iterator match(_template.begin(), _template.end(), listOrTag), matchEnd;
+		match != matchEnd;
+		++match
+	)
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+		addText(match->prefix().first, match->prefix().second);
+		lastMatchedPos = (*match)[0].second;
+		if ((*match)[1].matched)
+			parsed->parts.push_back({Kind::Tag, (*match)[1], nullptr, nullptr});
+		else if ((*match)[2].matched)
+			parsed->parts.push_back({Kind::List, (*match)[2], parseUncached((*match)[3]), nullptr});
+		else
 		{
+			assertThrow((*match)[4].length() > 0, WhiskersError, "");
+			parsed->parts.push_back({
+				Kind::Condition,
+				(*match)[4],
+				parseUncached((*match)[5]),
+				parseUncached((*match)[7])
+			});
+		}
+	}
+	addText(lastMatchedPos, _template.cend());
+	return parsed;
+}
+
+void Whiskers::render(
+	ParsedTemplate const& _template,
+	StringMap const& _parameters,
+	map<string, bool> const& _conditions,
+	StringListMap const& _listParameters,
+	string& _output
+)
+{
+	using Kind = ParsedTemplate::Kind;
+	for (ParsedTemplate::Part const& part: _template.parts)
+		switch (part.kind)
+		{
+		case Kind::Text:
+			_output += part.value;
+			break;
+		case Kind::Tag:
+		{
+			auto value = _parameters.find(part.value);
 			assertThrow(
-				_parameters.count(tagName),
+				value != _parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + part.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.source
 			);
-			return _parameters.at(tagName);
+			_output += value->second;
+			break;
 		}
-		else if (!listName.empty())
+		case Kind::List:
 		{
-			string templ(_match[3]);
+			auto values = _listParameters.find(part.value);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				values != _listParameters.end(),
+				WhiskersError, "List parameter " + part.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (auto const& parameters: values->second)
+				render(*part.body, joinMaps(_parameters, parameters), _conditions, {}, _output);
+			break;
 		}
-		else
+		case Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (part.value[0] == '+')
 			{
-				string tag = conditionName.substr(1);
+				string tag = part.value.substr(1);
+				auto value = _parameters.find(tag);
 				assertThrow(
-					_parameters.count(tag),
+					value != _parameters.end(),
 					WhiskersError, "Tag " + tag + " used as condition but was not set."
 				);
-				conditionValue = !_parameters.at(tag).empty();
+				conditionValue = !value->second.empty();
 			}
 			else
 			{
+				auto value = _conditions.find(part.value);
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					value != _conditions.end(),
+					WhiskersError, "Condition parameter " + part.value + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = value->second;
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
+			render(
+				conditionValue ? *part.body : *part.elseBody,
 				_parameters,
 				_conditions,
-				_listParameters
+				_listParameters,
+				_output
 			);
+			break;
+		}
 		}
-	});
 }
 
 Whiskers::StringMap Whiskers::joinMaps(
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::util
@@ -54,6 +55,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *
  * Note that lists cannot themselves contain lists - this would be a future feature.
  *
+ * Templates are parsed only once per distinct template string and thread, so constructing
+ * many Whiskers objects from the same string literal is cheap.
+ *
  * The elements are:
  *  - Regular parameter: <name>
  *    just replaced
@@ -94,11 +98,20 @@ private:
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// Template split into literal text and parameters.
+	struct ParsedTemplate;
+
+	/// @returns the parsed form of @a _template, which is parsed only on first use in each thread.
+	static std::shared_ptr<ParsedTemplate const> parse(std::string const& _template);
+	static std::shared_ptr<ParsedTemplate const> parseUncached(std::string const& _template);
+
+	/// Appends @a _template with all parameters replaced to @a _output.
+	static void render(
+		ParsedTemplate const& _template,
 		StringMap const& _parameters,
 		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
+		StringListMap const& _listParameters,
+		std::string& _output
 	);
 
 	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
@@ -23,6 +23,7 @@
 
 #include <libyul/AssemblyStack.h>
 
+#include <libyul/AST.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmParser.h>
@@ -36,6 +37,7 @@
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Suite.h>
@@ -44,11 +46,16 @@
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/JobScheduler.h>
+#include <libsolutil/Keccak256.h>
+
+#include <algorithm>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::langutil;
+using namespace solidity::util;
 
 namespace
 {
@@ -68,6 +75,22 @@ Dialect const& languageToDialect(AssemblyStack::Language _language, EVMVersion _
 	return Dialect::yulDeprecated();
 }
 
+/// @returns a copy of @a _object and its sub-objects that has not been analyzed yet.
+/// The code of the copy can be modified without affecting @a _object.
+shared_ptr<Object> copyObject(Object const& _object)
+{
+	auto copy = make_shared<Object>();
+	copy->name = _object.name;
+	copy->code = make_shared<Block>(ASTCopier{}.translate(*_object.code));
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			copy->subObjects.push_back(copyObject(*subObject));
+		else
+			copy->subObjects.push_back(subNode);
+	copy->subIndexByName = _object.subIndexByName;
+	return copy;
+}
+
 }
 
 
@@ -91,6 +114,26 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+void AssemblyStack::setParserResult(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	yulAssert(_object->analysisInfo, "Object has not been analyzed.");
+	m_errors.clear();
+	m_scanner.reset();
+	m_parserResult = move(_object);
+	m_analysisSuccessful = true;
+}
+
+bool AssemblyStack::analyzeCopy(Object const& _object)
+{
+	yulAssert(_object.code, "");
+	m_errors.clear();
+	m_scanner.reset();
+	m_parserResult = copyObject(_object);
+	return analyzeParsed();
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -98,10 +141,8 @@ void AssemblyStack::optimize()
 
 	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
 
-	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
-	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+	optimize(*m_parserResult, true, m_threads);
 }
 
 void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
@@ -165,28 +206,90 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize, m_threads);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+void AssemblyStack::optimize(Object& _object, bool _isCreation, size_t _threads)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+
+	// Sibling objects are independent, each job only replaces its own entry.
+	// The threads are shared among the sub-objects.
+	// Data nodes do not need any work, so only the objects count.
+	size_t objectCount = static_cast<size_t>(count_if(_object.subObjects.begin(), _object.subObjects.end(), [](auto const& _subNode) {
+		return dynamic_pointer_cast<Object>(_subNode) != nullptr;
+	}));
+	size_t subThreads = max<size_t>(1, _threads / max<size_t>(1, objectCount));
+	vector<function<void()>> jobs;
 	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
+		if (auto subObject = dynamic_pointer_cast<Object>(subNode))
+			jobs.emplace_back([this, &subNode, subObject, subThreads]() {
+				subNode = optimizeSubObject(subObject, subThreads);
+			});
+	runJobs(jobs, {}, _threads);
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
+	optional<size_t> functionParallelism;
+	if (m_optimiserSettings.optimizeFunctionsSeparately)
+		functionParallelism = _threads;
 	OptimiserSuite::run(
 		dialect,
 		meter.get(),
 		_object,
 		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps
+		m_optimiserSettings.yulOptimiserSteps,
+		{},
+		functionParallelism
 	);
+
+	// The sub-objects have already been analyzed by the jobs that optimized them and
+	// can be shared with other assembly stacks through the cache, so only the code of
+	// this object is analyzed again.
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	_object.analysisInfo = make_shared<AsmAnalysisInfo>();
+	AsmAnalyzer analyzer(*_object.analysisInfo, errorReporter, dialect, {}, _object.qualifiedDataNames());
+	yulAssert(analyzer.analyze(*_object.code), "Invalid source code after optimization.");
+}
+
+shared_ptr<Object> AssemblyStack::optimizeSubObject(shared_ptr<Object> _object, size_t _threads)
+{
+	if (!m_optimizedObjectCache)
+	{
+		optimize(*_object, false, _threads);
+		return _object;
+	}
+
+	// The printed object contains the code, data and names of all nested objects.
+	string key = _object->toString(&languageToDialect(m_language, m_evmVersion));
+	key += "\n" + to_string(static_cast<int>(m_language)) + " " + m_evmVersion.name();
+	key += "\n" + to_string(m_optimiserSettings.optimizeStackAllocation);
+	key += " " + to_string(m_optimiserSettings.expectedExecutionsPerDeployment);
+	key += " " + m_optimiserSettings.yulOptimiserSteps;
+	key += " " + to_string(m_optimiserSettings.optimizeFunctionsSeparately);
+	h256 hash = keccak256(key);
+
+	if (shared_ptr<Object> cached = m_optimizedObjectCache->find(hash))
+		return cached;
+	optimize(*_object, false, _threads);
+	return m_optimizedObjectCache->store(hash, move(_object));
+}
+
+shared_ptr<Object> OptimizedObjectCache::find(h256 const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_objects.find(_key);
+	return it == m_objects.end() ? nullptr : it->second;
+}
+
+shared_ptr<Object> OptimizedObjectCache::store(h256 const& _key, shared_ptr<Object> _object)
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_objects.emplace(_key, move(_object)).first->second;
 }
 
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
@@ -244,7 +347,7 @@ pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleAndGue
 	creationObject.sourceMappings = make_unique<string>(
 		evmasm::AssemblyItem::computeSourceMapping(
 			assembly.items(),
-			{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
+			{{m_scanner && m_scanner->charStream() ? m_scanner->charStream()->name() : "", 0}}
 		)
 	);
 
@@ -258,7 +361,7 @@ pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleAndGue
 		runtimeObject.sourceMappings = make_unique<string>(
 			evmasm::AssemblyItem::computeSourceMapping(
 				runtimeAssembly.items(),
-				{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
+				{{m_scanner && m_scanner->charStream() ? m_scanner->charStream()->name() : "", 0}}
 			)
 		);
 	}
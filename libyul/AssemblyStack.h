@@ -32,7 +32,11 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libsolutil/FixedHash.h>
+
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace solidity::langutil
@@ -52,6 +56,28 @@ struct MachineAssemblyObject
 	std::unique_ptr<std::string> sourceMappings;
 };
 
+/**
+ * Optimized sub-objects shared between the assembly stacks of a compilation, keyed by
+ * a hash of the unoptimized sub-object and the optimizer settings.
+ *
+ * The code of contracts created by other contracts is contained in the objects of
+ * all creating contracts. With this cache, it is optimized only once.
+ * The stored objects must not be modified. Can be used from several threads.
+ */
+class OptimizedObjectCache
+{
+public:
+	/// @returns the object stored under @a _key or nullptr if there is none.
+	std::shared_ptr<Object> find(util::h256 const& _key) const;
+	/// Stores @a _object under @a _key unless there already is an object stored under this key.
+	/// @returns the stored object.
+	std::shared_ptr<Object> store(util::h256 const& _key, std::shared_ptr<Object> _object);
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, std::shared_ptr<Object>> m_objects;
+};
+
 /*
  * Full assembly stack that can support EVM-assembly and Yul as input and EVM, EVM1.5 and
  * Ewasm as output.
@@ -73,12 +99,31 @@ public:
 	{}
 
 	/// @returns the scanner used during parsing
+	/// Not available if the object was not parsed by this stack.
 	langutil::Scanner const& scanner() const;
 
 	/// Runs parsing and analysis steps, returns false if input cannot be assembled.
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Uses @a _object instead of parsing source code. The object must already have been
+	/// parsed and successfully analyzed for the language of this stack, e.g. by another stack.
+	/// Multiple calls overwrite the previous state.
+	void setParserResult(std::shared_ptr<Object> _object);
+
+	/// Analyzes a copy of @a _object instead of parsing source code, so that it can be
+	/// optimized or translated without modifying @a _object.
+	/// @returns false if the copy cannot be assembled. Multiple calls overwrite the previous state.
+	bool analyzeCopy(Object const& _object);
+
+	/// Sets a cache used to look up and store optimized sub-objects.
+	/// Has to be set before calling optimize().
+	void setOptimizedObjectCache(std::shared_ptr<OptimizedObjectCache> _cache) { m_optimizedObjectCache = std::move(_cache); }
+
+	/// Sets the maximum number of threads used to optimize and compile sibling sub-objects
+	/// concurrently. The result does not depend on this setting.
+	void setThreads(size_t _threads) { m_threads = _threads; }
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -110,13 +155,19 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimizes and re-analyzes @a _object, using up to @a _threads threads for its sub-objects.
+	void optimize(yul::Object& _object, bool _isCreation, size_t _threads);
+	/// Optimizes the sub-object @a _object or retrieves its optimized version from the cache.
+	/// @returns the optimized object.
+	std::shared_ptr<yul::Object> optimizeSubObject(std::shared_ptr<yul::Object> _object, size_t _threads);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
+	std::shared_ptr<OptimizedObjectCache> m_optimizedObjectCache;
+	size_t m_threads = 1;
 
 	bool m_analysisSuccessful = false;
 	std::shared_ptr<yul::Object> m_parserResult;
@@ -22,12 +22,21 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/NameCollector.h>
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Common.h>
+
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -71,3 +80,98 @@ CompilabilityChecker::CompilabilityChecker(
 		}
 	}
 }
+
+void IncrementalCompilabilityChecker::update(Object& _object)
+{
+	yulAssert(_object.code, "");
+	Block& code = *_object.code;
+	if (!FunctionGrouper::alreadyGrouped(code))
+	{
+		CompilabilityChecker checker(m_dialect, _object, m_optimizeStackAllocation);
+		m_checkedHashes.clear();
+		m_checkedSignatures.clear();
+		m_unreachableVariables = move(checker.unreachableVariables);
+		m_stackDeficit = move(checker.stackDeficit);
+		return;
+	}
+
+	auto nameOf = [](Statement const& _statement) {
+		if (auto const* function = get_if<FunctionDefinition>(&_statement))
+			return function->name;
+		return YulString{};
+	};
+
+	// The code of a caller depends on the numbers of arguments and return values of the
+	// functions it calls, so callers are checked again if they change.
+	map<YulString, pair<size_t, size_t>> signatures;
+	for (Statement const& statement: code.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			signatures[function->name] = {function->parameters.size(), function->returnVariables.size()};
+	set<YulString> changedSignatures;
+	for (auto const& [name, signature]: signatures)
+		if (m_checkedSignatures.count(name) && m_checkedSignatures.at(name) != signature)
+			changedSignatures.insert(name);
+
+	map<YulString, uint64_t> hashes;
+	vector<bool> changed;
+	for (Statement const& statement: code.statements)
+	{
+		YulString name = nameOf(statement);
+		uint64_t hash = BlockHasher::hashCodeWithNames(statement);
+		hashes[name] = hash;
+		bool callsChangedSignature = false;
+		if (!changedSignatures.empty())
+		{
+			ReferencesCounter references;
+			references.visit(statement);
+			callsChangedSignature = any_of(changedSignatures.begin(), changedSignatures.end(), [&](YulString _callee) {
+				return references.references().count(_callee);
+			});
+		}
+		changed.push_back(
+			callsChangedSignature ||
+			!m_checkedHashes.count(name) ||
+			m_checkedHashes.at(name) != hash
+		);
+	}
+	for (auto const& [name, hash]: m_checkedHashes)
+		if (!hashes.count(name))
+		{
+			m_unreachableVariables.erase(name);
+			m_stackDeficit.erase(name);
+		}
+	m_checkedHashes = move(hashes);
+	m_checkedSignatures = move(signatures);
+	if (find(changed.begin(), changed.end(), true) == changed.end())
+		return;
+
+	// Only check the changed parts. The bodies of the other functions and the outermost block
+	// are removed while checking, the function signatures are still needed for calls.
+	auto bodyOf = [](Statement& _statement) -> Block& {
+		if (auto* function = get_if<FunctionDefinition>(&_statement))
+			return function->body;
+		return std::get<Block>(_statement);
+	};
+	vector<Block> unchangedBodies(code.statements.size());
+	for (size_t i = 0; i < code.statements.size(); ++i)
+		if (!changed[i])
+			swap(bodyOf(code.statements[i]), unchangedBodies[i]);
+	ScopeGuard restoreBodies([&]() {
+		for (size_t i = 0; i < code.statements.size(); ++i)
+			if (!changed[i])
+				swap(bodyOf(code.statements[i]), unchangedBodies[i]);
+	});
+
+	CompilabilityChecker checker(m_dialect, _object, m_optimizeStackAllocation);
+	for (size_t i = 0; i < code.statements.size(); ++i)
+		if (changed[i])
+		{
+			YulString name = nameOf(code.statements[i]);
+			m_unreachableVariables.erase(name);
+			m_stackDeficit.erase(name);
+			if (checker.unreachableVariables.count(name))
+				m_unreachableVariables[name] = move(checker.unreachableVariables.at(name));
+			if (checker.stackDeficit.count(name))
+				m_stackDeficit[name] = checker.stackDeficit.at(name);
+		}
+}
@@ -25,8 +25,11 @@
 #include <libyul/ASTForward.h>
 #include <libyul/Object.h>
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
+#include <utility>
 
 namespace solidity::yul
 {
@@ -49,4 +52,39 @@ struct CompilabilityChecker
 	std::map<YulString, int> stackDeficit;
 };
 
+/**
+ * Incremental version of the CompilabilityChecker for the code of a single object.
+ * It keeps the results for the outermost block and each function and on update only
+ * checks those again that changed since they were last checked. This is possible because
+ * every function has its own stack frame: only the signatures of other functions matter
+ * for a function, so the callers of a function are checked again if its signature changes.
+ *
+ * Checks all of the code if it is not grouped by the FunctionGrouper.
+ */
+class IncrementalCompilabilityChecker
+{
+public:
+	IncrementalCompilabilityChecker(Dialect const& _dialect, bool _optimizeStackAllocation):
+		m_dialect(_dialect), m_optimizeStackAllocation(_optimizeStackAllocation)
+	{}
+
+	/// Updates the results for the current code of @a _object.
+	/// While checking, the bodies of unchanged functions are temporarily removed from @a _object.
+	void update(Object& _object);
+
+	std::map<YulString, std::set<YulString>> const& unreachableVariables() const { return m_unreachableVariables; }
+	std::map<YulString, int> const& stackDeficit() const { return m_stackDeficit; }
+
+private:
+	Dialect const& m_dialect;
+	bool m_optimizeStackAllocation = false;
+	/// Hashes of the outermost block (stored under the empty name) and of the functions
+	/// at the time their results were determined.
+	std::map<YulString, uint64_t> m_checkedHashes;
+	/// Numbers of parameters and return variables of the functions at the time of the last update.
+	std::map<YulString, std::pair<size_t, size_t>> m_checkedSignatures;
+	std::map<YulString, std::set<YulString>> m_unreachableVariables;
+	std::map<YulString, int> m_stackDeficit;
+};
+
 }
@@ -22,6 +22,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
 
+#include <mutex>
+
 using namespace solidity::yul;
 using namespace std;
 using namespace solidity::langutil;
@@ -53,7 +55,12 @@ bool Dialect::validTypeForLiteral(LiteralKind _kind, YulString, YulString _type)
 Dialect const& Dialect::yulDeprecated()
 {
 	static unique_ptr<Dialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectMutex);
+		dialect.reset();
+	}};
+	lock_guard<mutex> lock(dialectMutex);
 
 	if (!dialect)
 	{
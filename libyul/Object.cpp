@@ -30,6 +30,8 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -106,10 +108,14 @@ vector<size_t> Object::pathToSubObject(YulString _qualifiedName) const
 			subIndexIt != object->subIndexByName.end(),
 			"Assembly object <" + _qualifiedName.str() + "> not found or does not contain code."
 		);
+		size_t subId = static_cast<size_t>(count_if(
+			object->subObjects.begin(),
+			object->subObjects.begin() + static_cast<ptrdiff_t>(subIndexIt->second),
+			[](shared_ptr<ObjectNode> const& _node) { return dynamic_cast<Object const*>(_node.get()); }
+		));
 		object = dynamic_cast<Object const*>(object->subObjects[subIndexIt->second].get());
 		yulAssert(object, "Assembly object <" + _qualifiedName.str() + "> not found or does not contain code.");
-		yulAssert(object->subId != numeric_limits<size_t>::max(), "");
-		path.push_back({object->subId});
+		path.push_back({subId});
 	}
 
 	return path;
@@ -83,11 +83,10 @@ public:
 	/// pathToSubObject("E2.F3.H4") == {1, 0, 2}
 	/// pathToSubObject("A1.E2") == {1}
 	/// The path must not lead to a @a Data object (will throw in that case).
+	/// The subId of an object is its position among the sub-objects of its parent
+	/// that are not @a Data objects.
 	std::vector<size_t> pathToSubObject(YulString _qualifiedName) const;
 
-	/// sub id for object if it is subobject of another object, max value if it is not subobject
-	size_t subId = std::numeric_limits<size_t>::max();
-
 	std::shared_ptr<Block> code;
 	std::vector<std::shared_ptr<ObjectNode>> subObjects;
 	std::map<YulString, size_t> subIndexByName;
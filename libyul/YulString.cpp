@@ -0,0 +1,148 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void YulStringRepository::reset()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_mutex);
+	repository.clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_mutex);
+	m_id = repository.m_nextResetCallbackId++;
+	YulStringRepository::resetCallbacks().emplace(m_id, move(_fun));
+}
+
+YulStringRepository::ResetCallback::~ResetCallback()
+{
+	lock_guard<mutex> lock(instance().m_mutex);
+	YulStringRepository::resetCallbacks().erase(m_id);
+}
+
+YulStringRepository::CompilationScope::CompilationScope()
+{
+	YulStringRepository& repository = instance();
+	unique_lock<mutex> lock(repository.m_mutex);
+	if (repository.m_activeScopes > 0 && repository.size() > repository.m_maxGenerationStrings)
+		repository.m_generationClosed = true;
+	if (repository.m_generationClosed)
+	{
+		++repository.m_waitingScopes;
+		repository.m_generationEnded.wait(lock, [&]() { return !repository.m_generationClosed; });
+		--repository.m_waitingScopes;
+	}
+	if (repository.m_activeScopes++ == 0)
+		repository.clear();
+}
+
+YulStringRepository::CompilationScope::~CompilationScope()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_mutex);
+	if (--repository.m_activeScopes == 0 && repository.m_generationClosed)
+	{
+		repository.m_generationClosed = false;
+		repository.m_generationEnded.notify_all();
+	}
+}
+
+size_t YulStringRepository::maxGenerationStrings()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_mutex);
+	return repository.m_maxGenerationStrings;
+}
+
+void YulStringRepository::setMaxGenerationStrings(size_t _strings)
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_mutex);
+	repository.m_maxGenerationStrings = _strings;
+}
+
+size_t YulStringRepository::waitingScopes()
+{
+	YulStringRepository& repository = instance();
+	lock_guard<mutex> lock(repository.m_mutex);
+	return repository.m_waitingScopes;
+}
+
+void YulStringRepository::clear()
+{
+	for (auto const& [id, cb]: resetCallbacks())
+		cb();
+	for (Shard& shard: m_shards)
+		shard.clear();
+}
+
+size_t YulStringRepository::size()
+{
+	size_t result = 0;
+	for (Shard& shard: m_shards)
+		result += shard.size();
+	return result;
+}
+
+size_t YulStringRepository::Shard::insert(string const& _string, uint64_t _hash)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto range = m_hashToIndex.equal_range(_hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (at(it->second) == _string)
+			return it->second;
+
+	size_t index = m_size;
+	auto [chunk, offset] = location(index);
+	yulAssert(chunk < c_maxChunks, "Too many distinct YulStrings.");
+	string* strings = m_chunks[chunk].load(memory_order_relaxed);
+	if (!strings)
+	{
+		strings = new string[c_firstChunkSize << chunk];
+		m_chunks[chunk].store(strings, memory_order_release);
+	}
+	strings[offset] = _string;
+	++m_size;
+	m_hashToIndex.emplace_hint(range.second, _hash, index);
+	return index;
+}
+
+void YulStringRepository::Shard::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr, memory_order_relaxed);
+	m_size = 0;
+	m_hashToIndex.clear();
+}
+
+size_t YulStringRepository::Shard::size()
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_size;
+}
@@ -21,13 +21,17 @@
 
 #pragma once
 
-#include <boost/noncopyable.hpp>
-
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
-#include <vector>
+#include <mutex>
 #include <string>
-#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -36,6 +40,11 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// Strings can be added and looked up concurrently from multiple threads: The repository is split
+/// into shards selected by the string hash, each with its own lock for insertions. Strings are stored
+/// in chunks that are never moved or freed before a reset, so looking up a string by its ID does
+/// not need a lock.
 class YulStringRepository
 {
 public:
@@ -56,17 +65,15 @@ public:
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		size_t shard = shardIndex(h);
+		return Handle{m_shards[shard].insert(_string, h) * c_shardCount + shard + 1, h};
+	}
+	std::string const& idToString(size_t _id) const
+	{
+		if (_id == 0)
+			return m_emptyString;
+		return m_shards[(_id - 1) % c_shardCount].at((_id - 1) / c_shardCount);
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -82,40 +89,124 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references
+	/// and no other thread may use YulStrings at the same time.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
-	/// Struct that registers a reset callback as a side-effect of its construction.
+	static void reset();
+	/// Struct that registers a reset callback as a side-effect of its construction
+	/// and removes it again when it is destroyed.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
+		ResetCallback(std::function<void()> _fun);
+		~ResetCallback();
+		ResetCallback(ResetCallback const&) = delete;
+		ResetCallback& operator=(ResetCallback const&) = delete;
+
+	private:
+		size_t m_id;
+	};
+	/// Marks the duration of a compilation that uses YulStrings.
+	/// Every compilation that can run concurrently with others must hold a scope for its whole
+	/// duration, and no YulStrings may be kept from one compilation to the next. Compilations
+	/// without a scope have to call reset() themselves while no other compilation is running.
+	///
+	/// Overlapping scopes form a generation that shares the repository, which is reset when the
+	/// first scope of a new generation starts. Once the repository holds more than
+	/// maxGenerationStrings() strings, new scopes wait until all scopes of the current
+	/// generation have ended, so that the repository cannot grow without bound.
+	/// Scopes must not be nested inside each other in the same thread.
+	class CompilationScope
+	{
+	public:
+		CompilationScope();
+		~CompilationScope();
+		CompilationScope(CompilationScope const&) = delete;
+		CompilationScope& operator=(CompilationScope const&) = delete;
+	};
+	/// @returns the number of strings after which no new compilation scopes can join the
+	/// current generation.
+	static size_t maxGenerationStrings();
+	/// Sets the number of strings after which no new compilation scopes can join the
+	/// current generation.
+	static void setMaxGenerationStrings(size_t _strings);
+	/// @returns the number of compilation scopes that wait for the current generation to end.
+	static size_t waitingScopes();
+
+private:
+	/// Part of the repository that holds the strings of a fixed subset of hashes.
+	class Shard
+	{
+	public:
+		Shard() = default;
+		Shard(Shard const&) = delete;
+		Shard& operator=(Shard const&) = delete;
+		~Shard() { clear(); }
+
+		/// @returns the index of @a _string inside the shard, adding it if it is not yet present.
+		size_t insert(std::string const& _string, std::uint64_t _hash);
+		std::string const& at(size_t _index) const
 		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
+			auto [chunk, offset] = location(_index);
+			return m_chunks[chunk].load(std::memory_order_acquire)[offset];
 		}
+		void clear();
+		size_t size();
+
+	private:
+		/// Chunk @a i holds `c_firstChunkSize << i` strings.
+		static constexpr size_t c_firstChunkSize = 64;
+		static constexpr size_t c_maxChunks = 40;
+
+		/// @returns the chunk and the offset inside the chunk of the string with index @a _index.
+		static std::pair<size_t, size_t> location(size_t _index)
+		{
+			size_t chunk = 0;
+			for (size_t blocks = _index / c_firstChunkSize + 1; blocks > 1; blocks >>= 1)
+				++chunk;
+			return {chunk, _index - c_firstChunkSize * ((size_t(1) << chunk) - 1)};
+		}
+
+		std::mutex m_mutex;
+		size_t m_size = 0;
+		std::unordered_multimap<std::uint64_t, size_t> m_hashToIndex;
+		std::array<std::atomic<std::string*>, c_maxChunks> m_chunks{};
 	};
 
-private:
+	static constexpr size_t c_shardCount = 16;
+	/// Default number of strings after which no new compilation scopes can join the current generation.
+	static constexpr size_t c_defaultMaxGenerationStrings = 1 << 20;
+	static size_t shardIndex(std::uint64_t _hash) { return static_cast<size_t>(_hash >> 32) % c_shardCount; }
+
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
+	/// Runs the reset callbacks and removes all strings. Requires @a m_mutex to be locked.
+	void clear();
+	/// @returns the number of strings in the repository.
+	size_t size();
+
+	/// Reset callbacks by the order of their registration.
+	static std::map<size_t, std::function<void()>>& resetCallbacks()
 	{
-		static std::vector<std::function<void()>> callbacks;
+		static std::map<size_t, std::function<void()>> callbacks;
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// Guards the list of reset callbacks and the state of the compilation scopes.
+	std::mutex m_mutex;
+	/// Notified when the last scope of a closed generation ends.
+	std::condition_variable m_generationEnded;
+	size_t m_activeScopes = 0;
+	size_t m_waitingScopes = 0;
+	size_t m_maxGenerationStrings = c_defaultMaxGenerationStrings;
+	size_t m_nextResetCallbackId = 0;
+	/// True if new scopes have to wait for the next generation.
+	bool m_generationClosed = false;
+	std::string const m_emptyString;
+	std::array<Shard, c_shardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
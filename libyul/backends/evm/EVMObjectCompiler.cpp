@@ -27,13 +27,24 @@
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
 #include <libevmasm/Assembly.h>
+#include <libsolutil/JobScheduler.h>
+
+#include <functional>
+#include <vector>
 
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _evm15,
+	bool _optimize,
+	size_t _threads
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _evm15);
+	EVMObjectCompiler compiler(_assembly, _dialect, _evm15, _threads);
 	compiler.run(_object, _optimize);
 }
 
@@ -42,13 +53,16 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	BuiltinContext context;
 	context.currentObject = &_object;
 
+	vector<pair<Object*, shared_ptr<AbstractAssembly>>> subAssemblies;
 	for (auto const& subNode: _object.subObjects)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			auto subAssemblyAndID = m_assembly.createSubAssembly();
+			// Object::pathToSubObject relies on sub-assemblies being numbered like the sub-objects.
+			// This way, sub-objects shared between several objects are not modified here.
+			yulAssert(subAssemblyAndID.second == subAssemblies.size(), "");
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
-			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize);
+			subAssemblies.emplace_back(subObject, move(subAssemblyAndID.first));
 		}
 		else
 		{
@@ -56,6 +70,16 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			context.subIDs[data.name] = m_assembly.appendData(data.data);
 		}
 
+	// Each sub-object is compiled into its own sub-assembly. If several of them fail,
+	// the error of the first one is reported, as when compiling one after the other.
+	size_t subThreads = max<size_t>(1, m_threads / max<size_t>(1, subAssemblies.size()));
+	vector<function<void()>> jobs;
+	for (auto const& [subObject, subAssembly]: subAssemblies)
+		jobs.emplace_back([&, subObject = subObject, subAssembly = subAssembly]() {
+			compile(*subObject, *subAssembly, m_dialect, m_evm15, _optimize, subThreads);
+		});
+	util::runJobs(jobs, {}, m_threads);
+
 	yulAssert(_object.analysisInfo, "No analysis info.");
 	yulAssert(_object.code, "No code.");
 	// We do not catch and re-throw the stack too deep exception here because it is a YulException,
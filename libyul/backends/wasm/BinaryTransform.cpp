@@ -39,11 +39,6 @@ using namespace solidity::util;
 namespace
 {
 
-bytes toBytes(uint8_t _b)
-{
-	return bytes(1, _b);
-}
-
 enum class LimitsKind: uint8_t
 {
 	Min = 0x00,
@@ -68,9 +63,9 @@ enum class Section: uint8_t
 	CODE = 0x0a
 };
 
-bytes toBytes(Section _s)
+uint8_t toByte(Section _s)
 {
-	return toBytes(uint8_t(_s));
+	return uint8_t(_s);
 }
 
 enum class ValueType: uint8_t
@@ -81,9 +76,9 @@ enum class ValueType: uint8_t
 	I32 = 0x7f
 };
 
-bytes toBytes(ValueType _vt)
+uint8_t toByte(ValueType _vt)
 {
-	return toBytes(uint8_t(_vt));
+	return uint8_t(_vt);
 }
 
 ValueType toValueType(wasm::Type _type)
@@ -102,9 +97,9 @@ enum class Export: uint8_t
 	Memory = 0x2
 };
 
-bytes toBytes(Export _export)
+uint8_t toByte(Export _export)
 {
-	return toBytes(uint8_t(_export));
+	return uint8_t(_export);
 }
 
 // NOTE: This is a subset of WebAssembly opcodes.
@@ -131,9 +126,9 @@ enum class Opcode: uint8_t
 	I64Const = 0x42,
 };
 
-bytes toBytes(Opcode _o)
+uint8_t toByte(Opcode _o)
 {
-	return toBytes(uint8_t(_o));
+	return uint8_t(_o);
 }
 
 Opcode constOpcodeFor(ValueType _type)
@@ -237,15 +232,22 @@ static map<string, uint8_t> const builtins = {
 	{"i64.extend_i32_u", 0xad},
 };
 
-bytes prefixSize(bytes _data)
+/// Inserts the size of the data written to @a _output since @a _start at @a _start.
+/// The size is only known afterwards and its LEB128 encoding has a variable length,
+/// so the data is moved once when the size is inserted.
+void prefixSize(bytes& _output, size_t _start)
 {
-	size_t size = _data.size();
-	return lebEncode(size) + move(_data);
+	yulAssert(_start <= _output.size(), "");
+	bytes size = lebEncode(_output.size() - _start);
+	_output.insert(_output.begin() + static_cast<ptrdiff_t>(_start), size.begin(), size.end());
 }
 
-bytes makeSection(Section _section, bytes _data)
+/// Starts a section by appending its ID to @a _output.
+/// @returns the start of the section content, to be passed to @a prefixSize.
+size_t beginSection(bytes& _output, Section _section)
 {
-	return toBytes(_section) + prefixSize(move(_data));
+	_output.push_back(toByte(_section));
+	return _output.size();
 }
 
 /// This is a kind of run-length-encoding of local types.
@@ -279,6 +281,13 @@ vector<pair<size_t, ValueType>> groupLocalVariables(vector<VariableDeclaration>
 }
 
 bytes BinaryTransform::run(Module const& _module)
+{
+	bytes output;
+	run(_module, output);
+	return output;
+}
+
+void BinaryTransform::run(Module const& _module, bytes& _output)
 {
 	map<Type, vector<string>> const types = typeToFunctionMap(_module.imports, _module.functions);
 
@@ -291,73 +300,83 @@ bytes BinaryTransform::run(Module const& _module)
 	yulAssert(functionTypes.size() == functionIDs.size(), "");
 	yulAssert(functionTypes.size() >= types.size(), "");
 
-	bytes ret{0, 'a', 's', 'm'};
+	size_t const moduleStart = _output.size();
+	_output += bytes{0, 'a', 's', 'm'};
 	// version
-	ret += bytes{1, 0, 0, 0};
-	ret += typeSection(types);
-	ret += importSection(_module.imports, functionTypes);
-	ret += functionSection(_module.functions, functionTypes);
-	ret += memorySection();
-	ret += globalSection(_module.globals);
-	ret += exportSection(functionIDs);
-
+	_output += bytes{1, 0, 0, 0};
+	typeSection(types, _output);
+	importSection(_module.imports, functionTypes, _output);
+	functionSection(_module.functions, functionTypes, _output);
+	memorySection(_output);
+	globalSection(_module.globals, _output);
+	exportSection(functionIDs, _output);
+
+	// Offsets are relative to the start of this module.
 	map<string, pair<size_t, size_t>> subModulePosAndSize;
 	for (auto const& [name, module]: _module.subModules)
 	{
 		// TODO should we prefix and / or shorten the name?
-		bytes data = BinaryTransform::run(module);
-		size_t const length = data.size();
-		ret += customSection(name, move(data));
+		size_t const sectionStart = beginSection(_output, Section::CUSTOM);
+		encodeName(name, _output);
+		size_t const dataStart = _output.size();
+		BinaryTransform::run(module, _output);
+		size_t const length = _output.size() - dataStart;
+		prefixSize(_output, sectionStart);
 		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
+		subModulePosAndSize[name] = {_output.size() - length - moduleStart, length};
 	}
 	for (auto const& [name, data]: _module.customSections)
 	{
-		size_t const length = data.size();
-		ret += customSection(name, data);
+		customSection(name, data, _output);
 		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
+		subModulePosAndSize[name] = {_output.size() - data.size() - moduleStart, data.size()};
 	}
 
 	BinaryTransform bt(
 		move(globalIDs),
 		move(functionIDs),
 		move(functionTypes),
-		move(subModulePosAndSize)
+		move(subModulePosAndSize),
+		_output
 	);
 
-	ret += bt.codeSection(_module.functions);
-	return ret;
+	bt.codeSection(_module.functions);
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
+void BinaryTransform::operator()(Literal const& _literal)
 {
-	return std::visit(GenericVisitor{
-		[&](uint32_t _value) -> bytes { return toBytes(Opcode::I32Const) + lebEncodeSigned(static_cast<int32_t>(_value)); },
-		[&](uint64_t _value) -> bytes { return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(_value)); },
+	std::visit(GenericVisitor{
+		[&](uint32_t _value) {
+			m_output.push_back(toByte(Opcode::I32Const));
+			m_output += lebEncodeSigned(static_cast<int32_t>(_value));
+		},
+		[&](uint64_t _value) {
+			m_output.push_back(toByte(Opcode::I64Const));
+			m_output += lebEncodeSigned(static_cast<int64_t>(_value));
+		},
 	}, _literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// StringLiteral is a special AST element used for certain builtins.
 	// It is not mapped to actual WebAssembly, and should be processed in visit(BuiltinCall).
 	yulAssert(false, "");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	m_output.push_back(toByte(Opcode::LocalGet));
+	m_output += lebEncode(m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globalIDs.at(_variable.name));
+	m_output.push_back(toByte(Opcode::GlobalGet));
+	m_output += lebEncode(m_globalIDs.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
@@ -366,20 +385,24 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		m_output.push_back(toByte(Opcode::I64Const));
+		m_output += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		return;
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		m_output.push_back(toByte(Opcode::I64Const));
+		m_output += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		return;
 	}
 
 	yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
 	// NOTE: the dialect ensures we have the right amount of arguments
-	bytes args = visit(_call.arguments);
-	bytes ret = move(args) + toBytes(builtins.at(_call.functionName));
+	visit(_call.arguments);
+	m_output.push_back(builtins.at(_call.functionName));
 	if (
 		_call.functionName.find(".load") != string::npos ||
 		_call.functionName.find(".store") != string::npos
@@ -388,103 +411,101 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		// into account to generate more efficient code but if the hint is invalid it could
 		// actually be more expensive. It's best to hint at 1-byte alignment if we don't plan
 		// to control the memory layout accordingly.
-		ret += bytes{{0, 0}}; // 2^0 == 1-byte alignment
-
-	return ret;
+		m_output += bytes{{0, 0}}; // 2^0 == 1-byte alignment
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functionIDs.at(_call.functionName));
+	visit(_call.arguments);
+	m_output.push_back(toByte(Opcode::Call));
+	m_output += lebEncode(m_functionIDs.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	m_output.push_back(toByte(Opcode::LocalSet));
+	m_output += lebEncode(m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globalIDs.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	m_output.push_back(toByte(Opcode::GlobalSet));
+	m_output += lebEncode(m_globalIDs.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	m_output.push_back(toByte(Opcode::If));
+	m_output.push_back(toByte(ValueType::Void));
 
 	m_labels.emplace_back();
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		m_output.push_back(toByte(Opcode::Else));
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	m_output.push_back(toByte(Opcode::End));
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	m_output.push_back(toByte(Opcode::Loop));
+	m_output.push_back(toByte(ValueType::Void));
 
 	m_labels.emplace_back(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	m_output.push_back(toByte(Opcode::End));
 }
 
-bytes BinaryTransform::operator()(Branch const& _branch)
+void BinaryTransform::operator()(Branch const& _branch)
 {
-	return toBytes(Opcode::Br) + encodeLabelIdx(_branch.label.name);
+	m_output.push_back(toByte(Opcode::Br));
+	m_output += encodeLabelIdx(_branch.label.name);
 }
 
-bytes BinaryTransform::operator()(BranchIf const& _branchIf)
+void BinaryTransform::operator()(BranchIf const& _branchIf)
 {
-	bytes result = std::visit(*this, *_branchIf.condition);
-	result += toBytes(Opcode::BrIf) + encodeLabelIdx(_branchIf.label.name);
-	return result;
+	std::visit(*this, *_branchIf.condition);
+	m_output.push_back(toByte(Opcode::BrIf));
+	m_output += encodeLabelIdx(_branchIf.label.name);
 }
 
-bytes BinaryTransform::operator()(Return const&)
+void BinaryTransform::operator()(Return const&)
 {
 	// Note that this does not work if the function returns a value.
-	return toBytes(Opcode::Return);
+	m_output.push_back(toByte(Opcode::Return));
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
 	m_labels.emplace_back(_block.labelName);
-	bytes result =
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	m_output.push_back(toByte(Opcode::Block));
+	m_output.push_back(toByte(ValueType::Void));
+	visit(_block.statements);
+	m_output.push_back(toByte(Opcode::End));
 	m_labels.pop_back();
-	return result;
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+void BinaryTransform::operator()(FunctionDefinition const& _function)
 {
-	bytes ret;
+	size_t const start = m_output.size();
 
 	vector<pair<size_t, ValueType>> localEntries = groupLocalVariables(_function.locals);
-	ret += lebEncode(localEntries.size());
+	m_output += lebEncode(localEntries.size());
 	for (pair<size_t, ValueType> const& entry: localEntries)
 	{
-		ret += lebEncode(entry.first);
-		ret += toBytes(entry.second);
+		m_output += lebEncode(entry.first);
+		m_output.push_back(toByte(entry.second));
 	}
 
 	m_locals.clear();
@@ -496,12 +517,12 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	m_output.push_back(toByte(Opcode::End));
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	return prefixSize(move(ret));
+	prefixSize(m_output, start);
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -590,114 +611,120 @@ map<string, size_t> BinaryTransform::enumerateFunctionTypes(map<Type, vector<str
 	return functionTypes;
 }
 
-bytes BinaryTransform::typeSection(map<BinaryTransform::Type, vector<string>> const& _typeToFunctionMap)
+void BinaryTransform::typeSection(map<BinaryTransform::Type, vector<string>> const& _typeToFunctionMap, bytes& _output)
 {
-	bytes result;
-	size_t index = 0;
+	size_t const start = beginSection(_output, Section::TYPE);
+	_output += lebEncode(_typeToFunctionMap.size());
 	for (Type const& type: _typeToFunctionMap | boost::adaptors::map_keys)
 	{
-		result += toBytes(ValueType::Function);
-		result += lebEncode(type.first.size()) + type.first;
-		result += lebEncode(type.second.size()) + type.second;
-
-		index++;
+		_output.push_back(toByte(ValueType::Function));
+		_output += lebEncode(type.first.size()) + type.first;
+		_output += lebEncode(type.second.size()) + type.second;
 	}
-
-	return makeSection(Section::TYPE, lebEncode(index) + move(result));
+	prefixSize(_output, start);
 }
 
-bytes BinaryTransform::importSection(
+void BinaryTransform::importSection(
 	vector<FunctionImport> const& _imports,
-	map<string, size_t> const& _functionTypes
+	map<string, size_t> const& _functionTypes,
+	bytes& _output
 )
 {
-	bytes result = lebEncode(_imports.size());
+	size_t const start = beginSection(_output, Section::IMPORT);
+	_output += lebEncode(_imports.size());
 	for (FunctionImport const& import: _imports)
 	{
 		uint8_t importKind = 0; // function
-		result +=
-			encodeName(import.module) +
-			encodeName(import.externalName) +
-			toBytes(importKind) +
-			lebEncode(_functionTypes.at(import.internalName));
+		encodeName(import.module, _output);
+		encodeName(import.externalName, _output);
+		_output.push_back(importKind);
+		_output += lebEncode(_functionTypes.at(import.internalName));
 	}
-	return makeSection(Section::IMPORT, move(result));
+	prefixSize(_output, start);
 }
 
-bytes BinaryTransform::functionSection(
+void BinaryTransform::functionSection(
 	vector<FunctionDefinition> const& _functions,
-	map<string, size_t> const& _functionTypes
+	map<string, size_t> const& _functionTypes,
+	bytes& _output
 )
 {
-	bytes result = lebEncode(_functions.size());
+	size_t const start = beginSection(_output, Section::FUNCTION);
+	_output += lebEncode(_functions.size());
 	for (auto const& fun: _functions)
-		result += lebEncode(_functionTypes.at(fun.name));
-	return makeSection(Section::FUNCTION, move(result));
+		_output += lebEncode(_functionTypes.at(fun.name));
+	prefixSize(_output, start);
 }
 
-bytes BinaryTransform::memorySection()
+void BinaryTransform::memorySection(bytes& _output)
 {
-	bytes result = lebEncode(1);
-	result.push_back(static_cast<uint8_t>(LimitsKind::Min));
-	result.push_back(1); // initial length
-	return makeSection(Section::MEMORY, move(result));
+	size_t const start = beginSection(_output, Section::MEMORY);
+	_output += lebEncode(1);
+	_output.push_back(static_cast<uint8_t>(LimitsKind::Min));
+	_output.push_back(1); // initial length
+	prefixSize(_output, start);
 }
 
-bytes BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> const& _globals)
+void BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> const& _globals, bytes& _output)
 {
-	bytes result = lebEncode(_globals.size());
+	size_t const start = beginSection(_output, Section::GLOBAL);
+	_output += lebEncode(_globals.size());
 	for (wasm::GlobalVariableDeclaration const& global: _globals)
 	{
 		ValueType globalType = toValueType(global.type);
-		result +=
-			toBytes(globalType) +
-			lebEncode(static_cast<uint8_t>(Mutability::Var)) +
-			toBytes(constOpcodeFor(globalType)) +
-			lebEncodeSigned(0) +
-			toBytes(Opcode::End);
+		_output.push_back(toByte(globalType));
+		_output += lebEncode(static_cast<uint8_t>(Mutability::Var));
+		_output.push_back(toByte(constOpcodeFor(globalType)));
+		_output += lebEncodeSigned(0);
+		_output.push_back(toByte(Opcode::End));
 	}
-
-	return makeSection(Section::GLOBAL, move(result));
+	prefixSize(_output, start);
 }
 
-bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
+void BinaryTransform::exportSection(map<string, size_t> const& _functionIDs, bytes& _output)
 {
+	size_t const start = beginSection(_output, Section::EXPORT);
 	bool hasMain = _functionIDs.count("main");
-	bytes result = lebEncode(hasMain ? 2 : 1);
-	result += encodeName("memory") + toBytes(Export::Memory) + lebEncode(0);
+	_output += lebEncode(hasMain ? 2 : 1);
+	encodeName("memory", _output);
+	_output.push_back(toByte(Export::Memory));
+	_output += lebEncode(0);
 	if (hasMain)
-		result += encodeName("main") + toBytes(Export::Function) + lebEncode(_functionIDs.at("main"));
-	return makeSection(Section::EXPORT, move(result));
+	{
+		encodeName("main", _output);
+		_output.push_back(toByte(Export::Function));
+		_output += lebEncode(_functionIDs.at("main"));
+	}
+	prefixSize(_output, start);
 }
 
-bytes BinaryTransform::customSection(string const& _name, bytes _data)
+void BinaryTransform::customSection(string const& _name, bytes const& _data, bytes& _output)
 {
-	bytes result = encodeName(_name) + move(_data);
-	return makeSection(Section::CUSTOM, move(result));
+	size_t const start = beginSection(_output, Section::CUSTOM);
+	encodeName(_name, _output);
+	_output += _data;
+	prefixSize(_output, start);
 }
 
-bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
+void BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
 {
-	bytes result = lebEncode(_functions.size());
+	size_t const start = beginSection(m_output, Section::CODE);
+	m_output += lebEncode(_functions.size());
 	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, move(result));
+		(*this)(fun);
+	prefixSize(m_output, start);
 }
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
+void BinaryTransform::visitReversed(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions | boost::adaptors::reversed)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
 bytes BinaryTransform::encodeLabelIdx(string const& _label) const
@@ -712,12 +739,13 @@ bytes BinaryTransform::encodeLabelIdx(string const& _label) const
 	yulAssert(false, "Label not found.");
 }
 
-bytes BinaryTransform::encodeName(string const& _name)
+void BinaryTransform::encodeName(string const& _name, bytes& _output)
 {
 	// UTF-8 is allowed here by the Wasm spec, but since all names here should stem from
 	// Solidity or Yul identifiers or similar, non-ascii characters ending up here
 	// is a very bad sign.
 	for (char c: _name)
 		yulAssert(uint8_t(c) <= 0x7f, "Non-ascii character found.");
-	return lebEncode(_name.size()) + asBytes(_name);
+	_output += lebEncode(_name.size());
+	_output.insert(_output.end(), _name.begin(), _name.end());
 }
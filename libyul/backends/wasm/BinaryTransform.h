@@ -33,41 +33,49 @@ namespace solidity::yul::wasm
 
 /**
  * Web assembly to binary transform.
+ *
+ * The module is written to a single output buffer. Sizes of sections and function bodies
+ * are inserted in front of them once they are complete.
  */
 class BinaryTransform
 {
 public:
 	static bytes run(Module const& _module);
 
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
+	void operator()(wasm::FunctionDefinition const& _function);
 
 private:
 	BinaryTransform(
 		std::map<std::string, size_t> _globalIDs,
 		std::map<std::string, size_t> _functionIDs,
 		std::map<std::string, size_t> _functionTypes,
-		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize
+		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize,
+		bytes& _output
 	):
 		m_globalIDs(std::move(_globalIDs)),
 		m_functionIDs(std::move(_functionIDs)),
 		m_functionTypes(std::move(_functionTypes)),
-		m_subModulePosAndSize(std::move(_subModulePosAndSize))
+		m_subModulePosAndSize(std::move(_subModulePosAndSize)),
+		m_output(_output)
 	{}
 
+	/// Appends the binary representation of @a _module to @a _output.
+	static void run(Module const& _module, bytes& _output);
+
 	using Type = std::pair<std::vector<std::uint8_t>, std::vector<std::uint8_t>>;
 	static Type typeOf(wasm::FunctionImport const& _import);
 	static Type typeOf(wasm::FunctionDefinition const& _funDef);
@@ -87,27 +95,29 @@ private:
 		std::map<Type, std::vector<std::string>> const& _typeToFunctionMap
 	);
 
-	static bytes typeSection(std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
-	static bytes importSection(
+	static void typeSection(std::map<Type, std::vector<std::string>> const& _typeToFunctionMap, bytes& _output);
+	static void importSection(
 		std::vector<wasm::FunctionImport> const& _imports,
-		std::map<std::string, size_t> const& _functionTypes
+		std::map<std::string, size_t> const& _functionTypes,
+		bytes& _output
 	);
-	static bytes functionSection(
+	static void functionSection(
 		std::vector<wasm::FunctionDefinition> const& _functions,
-		std::map<std::string, size_t> const& _functionTypes
+		std::map<std::string, size_t> const& _functionTypes,
+		bytes& _output
 	);
-	static bytes memorySection();
-	static bytes globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals);
-	static bytes exportSection(std::map<std::string, size_t> const& _functionIDs);
-	static bytes customSection(std::string const& _name, bytes _data);
-	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	static void memorySection(bytes& _output);
+	static void globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals, bytes& _output);
+	static void exportSection(std::map<std::string, size_t> const& _functionIDs, bytes& _output);
+	static void customSection(std::string const& _name, bytes const& _data, bytes& _output);
+	void codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	void visit(std::vector<wasm::Expression> const& _expressions);
+	void visitReversed(std::vector<wasm::Expression> const& _expressions);
 
 	bytes encodeLabelIdx(std::string const& _label) const;
 
-	static bytes encodeName(std::string const& _name);
+	static void encodeName(std::string const& _name, bytes& _output);
 
 	std::map<std::string, size_t> const m_globalIDs;
 	std::map<std::string, size_t> const m_functionIDs;
@@ -115,6 +125,8 @@ private:
 	/// The map of submodules, where the pair refers to the [offset, length]. The offset is
 	/// an absolute offset within the resulting assembled bytecode.
 	std::map<std::string, std::pair<size_t, size_t>> const m_subModulePosAndSize;
+	/// Output of the whole module, including the enclosing modules.
+	bytes& m_output;
 
 	std::map<std::string, size_t> m_locals;
 	std::vector<std::string> m_labels;
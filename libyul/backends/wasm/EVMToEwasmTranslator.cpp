@@ -23,6 +23,7 @@
 
 #include <libyul/backends/wasm/WordSizeTransform.h>
 #include <libyul/backends/wasm/WasmDialect.h>
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/MainFunction.h>
@@ -31,6 +32,7 @@
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 
 #include <libyul/AsmParser.h>
 #include <libyul/AsmAnalysis.h>
@@ -42,6 +44,10 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libsolutil/CommonData.h>
+
+#include <mutex>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -60,26 +66,117 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// The parsed polyfill functions, shared by all translators.
+struct Polyfill
+{
+	Block code;
+	/// Position of each function in the statements of @a code.
+	map<YulString, size_t> functionIndices;
+	/// Polyfill functions called by each polyfill function.
+	map<YulString, set<YulString>> callees;
+};
+
+shared_ptr<Polyfill const> parsePolyfill()
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
+		"{" +
+			string(solidity::yul::wasm::polyfill::Arithmetic) +
+			string(solidity::yul::wasm::polyfill::Bitwise) +
+			string(solidity::yul::wasm::polyfill::Comparison) +
+			string(solidity::yul::wasm::polyfill::Conversion) +
+			string(solidity::yul::wasm::polyfill::Interface) +
+			string(solidity::yul::wasm::polyfill::Keccak) +
+			string(solidity::yul::wasm::polyfill::Logical) +
+			string(solidity::yul::wasm::polyfill::Memory) +
+		"}", ""))};
+	shared_ptr<Block> code = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
+	if (!errors.empty())
+	{
+		string message;
+		for (auto const& err: errors)
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+		yulAssert(false, message);
+	}
+
+	auto polyfill = make_shared<Polyfill>();
+	polyfill->code = move(*code);
+	for (size_t i = 0; i < polyfill->code.statements.size(); ++i)
+		polyfill->functionIndices[std::get<FunctionDefinition>(polyfill->code.statements[i]).name] = i;
+	for (auto& [function, callees]: CallGraphGenerator::callGraph(polyfill->code).functionCalls)
+		for (YulString callee: callees)
+			if (polyfill->functionIndices.count(callee))
+				polyfill->callees[function].insert(callee);
+	return polyfill;
+}
+
+/// @returns the polyfill, which is only parsed again after the YulStrings have been reset.
+shared_ptr<Polyfill const> polyfill()
+{
+	static shared_ptr<Polyfill const> polyfill;
+	static mutex polyfillMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(polyfillMutex);
+		polyfill.reset();
+	}};
+	lock_guard<mutex> lock(polyfillMutex);
+	if (!polyfill)
+		polyfill = parsePolyfill();
+	return polyfill;
+}
+
+}
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	shared_ptr<Polyfill const> polyfill = ::polyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
 	NameDispenser nameDispenser{m_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{m_dialect, nameDispenser, reservedIdentifiers};
+	AnalysisManager analyses{m_dialect};
+	OptimiserStepContext context{m_dialect, nameDispenser, reservedIdentifiers, analyses};
 
+	// The analyses are discarded after every step, since the steps can change the code.
 	FunctionHoister::run(context, ast);
+	analyses.invalidate();
 	FunctionGrouper::run(context, ast);
+	analyses.invalidate();
 	MainFunction::run(context, ast);
+	analyses.invalidate();
 	ForLoopConditionIntoBody::run(context, ast);
+	analyses.invalidate();
 	ExpressionSplitter::run(context, ast);
+	analyses.invalidate();
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, keys(polyfill->functionIndices)}(ast);
+
+	// Copy the polyfill functions that are called, directly or indirectly, in their original order.
+	set<YulString> usedFunctions;
+	vector<YulString> toVisit;
+	for (auto const& [caller, callees]: CallGraphGenerator::callGraph(ast).functionCalls)
+		for (YulString callee: callees)
+			if (polyfill->functionIndices.count(callee) && usedFunctions.insert(callee).second)
+				toVisit.push_back(callee);
+	while (!toVisit.empty())
+	{
+		YulString function = toVisit.back();
+		toVisit.pop_back();
+		if (polyfill->callees.count(function))
+			for (YulString callee: polyfill->callees.at(function))
+				if (usedFunctions.insert(callee).second)
+					toVisit.push_back(callee);
+	}
+	set<size_t> usedIndices;
+	for (YulString function: usedFunctions)
+		usedIndices.insert(polyfill->functionIndices.at(function));
+	for (size_t index: usedIndices)
+		ast.statements.emplace_back(ASTCopier{}.translate(polyfill->code.statements[index]));
 
 	Object ret;
 	ret.name = _object.name;
@@ -111,32 +208,3 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 
 	return ret;
 }
-
-void EVMToEwasmTranslator::parsePolyfill()
-{
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
-		"{" +
-			string(solidity::yul::wasm::polyfill::Arithmetic) +
-			string(solidity::yul::wasm::polyfill::Bitwise) +
-			string(solidity::yul::wasm::polyfill::Comparison) +
-			string(solidity::yul::wasm::polyfill::Conversion) +
-			string(solidity::yul::wasm::polyfill::Interface) +
-			string(solidity::yul::wasm::polyfill::Keccak) +
-			string(solidity::yul::wasm::polyfill::Logical) +
-			string(solidity::yul::wasm::polyfill::Memory) +
-		"}", ""))};
-	m_polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
-	if (!errors.empty())
-	{
-		string message;
-		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
-		yulAssert(false, message);
-	}
-
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
-}
@@ -36,12 +36,7 @@ public:
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
-
 	Dialect const& m_dialect;
-
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
 };
 
 }
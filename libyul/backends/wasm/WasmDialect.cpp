@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -166,7 +168,12 @@ BuiltinFunction const* WasmDialect::equalityFunction(YulString _type) const
 WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectMutex);
+		dialect.reset();
+	}};
+	lock_guard<mutex> lock(dialectMutex);
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
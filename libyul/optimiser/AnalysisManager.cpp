@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for analyses of the whole code that are used by several optimiser steps.
+ */
+
+#include <libyul/optimiser/AnalysisManager.h>
+
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <range/v3/algorithm/any_of.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+CallGraph const& AnalysisManager::callGraph(Block const& _ast)
+{
+	discardIfOtherBlock(_ast);
+	return storedCallGraph(_ast);
+}
+
+map<YulString, SideEffects> const& AnalysisManager::sideEffects(Block const& _ast)
+{
+	discardIfOtherBlock(_ast);
+	if (!m_sideEffects)
+		m_sideEffects = SideEffectsPropagator::sideEffects(m_dialect, storedCallGraph(_ast));
+	return *m_sideEffects;
+}
+
+bool AnalysisManager::containsMSize(Block const& _ast)
+{
+	discardIfOtherBlock(_ast);
+	if (!m_containsMSize)
+		m_containsMSize = containsMSize(storedCallGraph(_ast));
+	return *m_containsMSize;
+}
+
+void AnalysisManager::invalidate()
+{
+	m_ast = nullptr;
+	m_callGraph.reset();
+	m_sideEffects.reset();
+	m_containsMSize.reset();
+}
+
+bool AnalysisManager::resultsMatch(Block const& _ast) const
+{
+	if (m_ast != &_ast)
+		return true;
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
+	if (m_callGraph && (
+		m_callGraph->functionCalls != callGraph.functionCalls ||
+		m_callGraph->functionsWithLoops != callGraph.functionsWithLoops
+	))
+		return false;
+	if (m_sideEffects && *m_sideEffects != SideEffectsPropagator::sideEffects(m_dialect, callGraph))
+		return false;
+	if (m_containsMSize && *m_containsMSize != containsMSize(callGraph))
+		return false;
+	return true;
+}
+
+CallGraph const& AnalysisManager::storedCallGraph(Block const& _ast)
+{
+	if (!m_callGraph)
+		m_callGraph = CallGraphGenerator::callGraph(_ast);
+	return *m_callGraph;
+}
+
+bool AnalysisManager::containsMSize(CallGraph const& _callGraph) const
+{
+	// The call graph contains calls to builtins, so it can be used instead of walking the code again.
+	return ranges::any_of(_callGraph.functionCalls, [&](auto const& _calls) {
+		return ranges::any_of(_calls.second, [&](YulString _callee) {
+			BuiltinFunction const* builtin = m_dialect.builtin(_callee);
+			return builtin && builtin->isMSize;
+		});
+	});
+}
+
+void AnalysisManager::discardIfOtherBlock(Block const& _ast)
+{
+	if (m_ast != &_ast)
+	{
+		invalidate();
+		m_ast = &_ast;
+	}
+}
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for analyses of the whole code that are used by several optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <map>
+#include <optional>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct Block;
+
+/**
+ * Keeps the results of analyses of the whole code that are needed by several optimiser
+ * steps (call graph, side effects of functions and whether msize is used), so that
+ * they are computed only once as long as the code does not change.
+ *
+ * Results are kept until invalidate() is called, which the owner has to do whenever the
+ * code might have changed. The OptimiserSuite does this after every step that is not known
+ * to preserve the results, and steps that query results after modifying the code themselves
+ * do it too. Results are also discarded if they are queried for a different block.
+ *
+ * References returned by the functions are valid until the results are discarded.
+ */
+class AnalysisManager
+{
+public:
+	explicit AnalysisManager(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	/// @returns the call graph of @a _ast, as computed by CallGraphGenerator.
+	CallGraph const& callGraph(Block const& _ast);
+	/// @returns the side effects of all functions in @a _ast, as computed by SideEffectsPropagator.
+	std::map<YulString, SideEffects> const& sideEffects(Block const& _ast);
+	/// @returns true if @a _ast contains the msize instruction.
+	bool containsMSize(Block const& _ast);
+
+	/// Discards all results.
+	void invalidate();
+	/// @returns false if results are stored for @a _ast that differ from the results of
+	/// analysing it again. Used to check that code changes keep the results intact.
+	bool resultsMatch(Block const& _ast) const;
+
+private:
+	/// Discards the results unless they are for @a _ast.
+	void discardIfOtherBlock(Block const& _ast);
+	/// @returns the stored call graph, computing it first if needed.
+	CallGraph const& storedCallGraph(Block const& _ast);
+	/// @returns true if the code with call graph @a _callGraph contains the msize instruction.
+	bool containsMSize(CallGraph const& _callGraph) const;
+
+	Dialect const& m_dialect;
+	/// The block the stored results are for.
+	Block const* m_ast = nullptr;
+	std::optional<CallGraph> m_callGraph;
+	std::optional<std::map<YulString, SideEffects>> m_sideEffects;
+	std::optional<bool> m_containsMSize;
+};
+
+}
@@ -48,11 +48,35 @@ static constexpr uint64_t compileTimeLiteralHash(char const (&_literal)[N])
 std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 {
 	std::map<Block const*, uint64_t> result;
-	BlockHasher blockHasher(result);
+	BlockHasher blockHasher(&result, Mode::Blocks);
 	blockHasher(_block);
 	return result;
 }
 
+uint64_t BlockHasher::hashCodeUpToRenaming(Block const& _block)
+{
+	BlockHasher blockHasher(nullptr, Mode::CodeUpToRenaming);
+	blockHasher(_block);
+	// Names that are not declared in the code are builtins, which have to be distinguished.
+	for (YulString name: blockHasher.m_externalReferences)
+		blockHasher.hash64(name.hash());
+	return blockHasher.m_hash;
+}
+
+uint64_t BlockHasher::hashCodeWithNames(Block const& _block)
+{
+	BlockHasher blockHasher(nullptr, Mode::CodeWithNames);
+	blockHasher(_block);
+	return blockHasher.m_hash;
+}
+
+uint64_t BlockHasher::hashCodeWithNames(Statement const& _statement)
+{
+	BlockHasher blockHasher(nullptr, Mode::CodeWithNames);
+	blockHasher.visit(_statement);
+	return blockHasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -64,6 +88,11 @@ void BlockHasher::operator()(Literal const& _literal)
 void BlockHasher::operator()(Identifier const& _identifier)
 {
 	hash64(compileTimeLiteralHash("Identifier"));
+	if (m_mode == Mode::CodeWithNames)
+	{
+		hash64(_identifier.name.hash());
+		return;
+	}
 	auto it = m_variableReferences.find(_identifier.name);
 	if (it == m_variableReferences.end())
 	{
@@ -83,7 +112,10 @@ void BlockHasher::operator()(Identifier const& _identifier)
 void BlockHasher::operator()(FunctionCall const& _funCall)
 {
 	hash64(compileTimeLiteralHash("FunctionCall"));
-	hash64(_funCall.functionName.name.hash());
+	if (m_mode == Mode::CodeUpToRenaming)
+		(*this)(_funCall.functionName);
+	else
+		hash64(_funCall.functionName.name.hash());
 	hash64(_funCall.arguments.size());
 	ASTWalker::operator()(_funCall);
 }
@@ -106,15 +138,7 @@ void BlockHasher::operator()(Assignment const& _assignment)
 void BlockHasher::operator()(VariableDeclaration const& _varDecl)
 {
 	hash64(compileTimeLiteralHash("VariableDeclaration"));
-	hash64(_varDecl.variables.size());
-	for (auto const& var: _varDecl.variables)
-	{
-		yulAssert(!m_variableReferences.count(var.name), "");
-		m_variableReferences[var.name] = VariableReference{
-			m_internalIdentifierCount++,
-			false
-		};
-	}
+	hashTypedNames(_varDecl.variables);
 	ASTWalker::operator()(_varDecl);
 }
 
@@ -146,12 +170,32 @@ void BlockHasher::operator()(Switch const& _switch)
 void BlockHasher::operator()(FunctionDefinition const& _funDef)
 {
 	hash64(compileTimeLiteralHash("FunctionDefinition"));
-	ASTWalker::operator()(_funDef);
+	if (m_mode == Mode::Blocks)
+	{
+		ASTWalker::operator()(_funDef);
+		return;
+	}
+
+	if (m_mode == Mode::CodeUpToRenaming)
+		(*this)(Identifier{{}, _funDef.name});
+	else
+		hash64(_funDef.name.hash());
+	// Parameters and return variables are declared in a hasher of their own, so that
+	// references to them in the body are resolved like references to local variables.
+	BlockHasher functionHasher(m_blockHashes, m_mode);
+	functionHasher.hashTypedNames(_funDef.parameters);
+	functionHasher.hashTypedNames(_funDef.returnVariables);
+	functionHasher(_funDef.body);
+
+	hash64(functionHasher.m_hash);
+	hash64(functionHasher.m_externalReferences.size());
+	for (auto& externalReference: functionHasher.m_externalReferences)
+		(*this)(Identifier{{}, externalReference});
 }
 
 void BlockHasher::operator()(ForLoop const& _loop)
 {
-	yulAssert(_loop.pre.statements.empty(), "");
+	yulAssert(m_mode != Mode::Blocks || _loop.pre.statements.empty(), "");
 
 	hash64(compileTimeLiteralHash("ForLoop"));
 	ASTWalker::operator()(_loop);
@@ -182,11 +226,17 @@ void BlockHasher::operator()(Block const& _block)
 	if (_block.statements.empty())
 		return;
 
-	BlockHasher subBlockHasher(m_blockHashes);
+	BlockHasher subBlockHasher(m_blockHashes, m_mode);
+	// Functions are visible in the whole block, also before their definition.
+	if (m_mode == Mode::CodeUpToRenaming)
+		for (auto const& statement: _block.statements)
+			if (auto const* function = get_if<FunctionDefinition>(&statement))
+				subBlockHasher.declareVariable(function->name);
 	for (auto const& statement: _block.statements)
 		subBlockHasher.visit(statement);
 
-	m_blockHashes[&_block] = subBlockHasher.m_hash;
+	if (m_blockHashes)
+		(*m_blockHashes)[&_block] = subBlockHasher.m_hash;
 
 	hash64(subBlockHasher.m_hash);
 	hash64(subBlockHasher.m_externalReferences.size());
@@ -194,3 +244,27 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+void BlockHasher::declareVariable(YulString _name)
+{
+	if (m_mode == Mode::CodeWithNames)
+	{
+		hash64(_name.hash());
+		return;
+	}
+	yulAssert(!m_variableReferences.count(_name), "");
+	m_variableReferences[_name] = VariableReference{
+		m_internalIdentifierCount++,
+		false
+	};
+}
+
+void BlockHasher::hashTypedNames(vector<TypedName> const& _names)
+{
+	hash64(_names.size());
+	for (TypedName const& name: _names)
+	{
+		declareVariable(name.name);
+		hash64(name.type.hash());
+	}
+}
@@ -39,7 +39,11 @@ namespace solidity::yul
  * Similarly, the names of referenced external variables are not considered,
  * but replaced by a (distinct) counter as well.
  *
- * Prerequisite: Disambiguator, ForLoopInitRewriter
+ * Apart from the hashes of the single blocks, it can compute hashes of whole pieces
+ * of code that also take the signatures of the functions into account, either up to
+ * a consistent renaming of variables and functions or including all names.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter (only for run())
  */
 class BlockHasher: public ASTWalker
 {
@@ -63,12 +67,38 @@ public:
 	void operator()(Block const& _block) override;
 
 	static std::map<Block const*, uint64_t> run(Block const& _block);
+	/// @returns a hash of all of @a _block. In contrast to the hashes returned by run(),
+	/// it also depends on the signatures of functions, but it does not change if variables
+	/// and functions declared in @a _block are renamed consistently.
+	static uint64_t hashCodeUpToRenaming(Block const& _block);
+	/// @returns a hash of all of @a _block. In contrast to the hashes returned by run(),
+	/// it also depends on the signatures of functions and all names are hashed as they are,
+	/// i.e. renaming a variable changes the hash.
+	static uint64_t hashCodeWithNames(Block const& _block);
+	/// @returns a hash of @a _statement like hashCodeWithNames() for blocks.
+	static uint64_t hashCodeWithNames(Statement const& _statement);
 
 	static constexpr uint64_t fnvPrime = 1099511628211u;
 	static constexpr uint64_t fnvEmptyHash = 14695981039346656037u;
 
 private:
-	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
+	enum class Mode
+	{
+		/// Only the bodies of functions are hashed.
+		Blocks,
+		/// Function signatures are hashed as well and the names of functions
+		/// are replaced by counters like those of variables.
+		CodeUpToRenaming,
+		/// Function signatures are hashed and names are not replaced by counters.
+		CodeWithNames
+	};
+
+	BlockHasher(std::map<Block const*, uint64_t>* _blockHashes, Mode _mode):
+		m_blockHashes(_blockHashes), m_mode(_mode)
+	{}
+
+	void declareVariable(YulString _name);
+	void hashTypedNames(std::vector<TypedName> const& _names);
 
 	void hash8(uint8_t _value)
 	{
@@ -91,7 +121,9 @@ private:
 		hash32(static_cast<uint32_t>(_value >> 32));
 	}
 
-	std::map<Block const*, uint64_t>& m_blockHashes;
+	/// Hashes of the blocks visited so far, if requested.
+	std::map<Block const*, uint64_t>* m_blockHashes = nullptr;
+	Mode m_mode = Mode::Blocks;
 
 	uint64_t m_hash = fnvEmptyHash;
 	struct VariableReference
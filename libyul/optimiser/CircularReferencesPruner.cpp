@@ -17,7 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #include <libyul/optimiser/CircularReferencesPruner.h>
 
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/AST.h>
 
@@ -28,13 +28,12 @@ using namespace solidity::yul;
 
 void CircularReferencesPruner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CircularReferencesPruner{_context.reservedIdentifiers}(_ast);
+	CircularReferencesPruner{_context.reservedIdentifiers, _context.analyses.callGraph(_ast)}(_ast);
 }
 
 void CircularReferencesPruner::operator()(Block& _block)
 {
-	set<YulString> functionsToKeep =
-		functionsCalledFromOutermostContext(CallGraphGenerator::callGraph(_block));
+	set<YulString> functionsToKeep = functionsCalledFromOutermostContext(m_callGraph);
 
 	for (auto&& statement: _block.statements)
 		if (holds_alternative<FunctionDefinition>(statement))
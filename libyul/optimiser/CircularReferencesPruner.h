@@ -44,8 +44,9 @@ public:
 	using ASTModifier::operator();
 	void operator()(Block& _block) override;
 private:
-	CircularReferencesPruner(std::set<YulString> const& _reservedIdentifiers):
-		m_reservedIdentifiers(_reservedIdentifiers)
+	CircularReferencesPruner(std::set<YulString> const& _reservedIdentifiers, CallGraph const& _callGraph):
+		m_reservedIdentifiers(_reservedIdentifiers),
+		m_callGraph(_callGraph)
 	{}
 
 	/// Run a breadth-first search starting from the outermost context and
@@ -54,6 +55,8 @@ private:
 	std::set<YulString> functionsCalledFromOutermostContext(CallGraph const& _callGraph);
 
 	std::set<YulString> const& m_reservedIdentifiers;
+	/// Call graph of the code the pruner is run on.
+	CallGraph const& m_callGraph;
 };
 
 }
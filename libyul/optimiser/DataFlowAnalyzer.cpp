@@ -224,6 +224,7 @@ void DataFlowAnalyzer::operator()(ForLoop& _for)
 
 void DataFlowAnalyzer::operator()(Block& _block)
 {
+	m_blockSideEffects.erase(&_block);
 	size_t numScopes = m_variableScopes.size();
 	pushScope(false);
 	ASTModifier::operator()(_block);
@@ -345,7 +346,7 @@ void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
-	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
+	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects, m_blockSideEffects);
 	if (sideEffects.invalidatesStorage())
 		m_storage.clear();
 	if (sideEffects.invalidatesMemory())
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -113,6 +114,7 @@ protected:
 	void assignValue(YulString _variable, Expression const* _value);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
+	/// Uses and updates m_blockSideEffects.
 	void clearKnowledgeIfInvalidated(Block const& _block);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
@@ -158,6 +160,10 @@ protected:
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Side effects of blocks that are not being visited at the moment. The entry of a block
+	/// is removed when it is visited (and thus possibly modified), so that code nested in
+	/// loops and switches is only analysed again after it changed.
+	std::unordered_map<Block const*, SideEffects> m_blockSideEffects;
 
 	/// Current values of variables, always movable.
 	std::map<YulString, AssignedValue> m_value;
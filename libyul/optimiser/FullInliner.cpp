@@ -28,7 +28,7 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -42,13 +42,19 @@ using namespace solidity::yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	FullInliner inliner{_ast, _context.dispenser, _context.dialect, _context.analyses};
 	inliner.run(Pass::InlineTiny);
+	_context.analyses.invalidate();
 	inliner.run(Pass::InlineRest);
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
-	m_ast(_ast), m_nameDispenser(_dispenser), m_dialect(_dialect)
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	Dialect const& _dialect,
+	AnalysisManager& _analyses
+):
+	m_ast(_ast), m_nameDispenser(_dispenser), m_dialect(_dialect), m_analyses(_analyses)
 {
 	// Determine constants
 	SSAValueTracker tracker;
@@ -87,7 +93,7 @@ void FullInliner::run(Pass _pass)
 	// function name) order.
 	// We use stable_sort below to keep the inlining order of two functions
 	// with the same depth.
-	map<YulString, size_t> depths = callDepths();
+	map<YulString, size_t> depths = callDepths(m_analyses.callGraph(m_ast));
 	vector<FunctionDefinition*> functions;
 	for (auto& statement: m_ast.statements)
 		if (holds_alternative<FunctionDefinition>(statement))
@@ -109,13 +115,12 @@ void FullInliner::run(Pass _pass)
 			handleBlock({}, std::get<Block>(statement));
 }
 
-map<YulString, size_t> FullInliner::callDepths() const
+map<YulString, size_t> FullInliner::callDepths(CallGraph _callGraph) const
 {
-	CallGraph cg = CallGraphGenerator::callGraph(m_ast);
-	cg.functionCalls.erase(""_yulstring);
+	_callGraph.functionCalls.erase(""_yulstring);
 
 	// Remove calls to builtin functions.
-	for (auto& call: cg.functionCalls)
+	for (auto& call: _callGraph.functionCalls)
 		for (auto it = call.second.begin(); it != call.second.end();)
 			if (m_dialect.builtin(*it))
 				it = call.second.erase(it);
@@ -128,20 +133,20 @@ map<YulString, size_t> FullInliner::callDepths() const
 	while (true)
 	{
 		vector<YulString> removed;
-		for (auto it = cg.functionCalls.begin(); it != cg.functionCalls.end();)
+		for (auto it = _callGraph.functionCalls.begin(); it != _callGraph.functionCalls.end();)
 		{
 			auto const& [fun, callees] = *it;
 			if (callees.empty())
 			{
 				removed.emplace_back(fun);
 				depths[fun] = currentDepth;
-				it = cg.functionCalls.erase(it);
+				it = _callGraph.functionCalls.erase(it);
 			}
 			else
 				++it;
 		}
 
-		for (auto& call: cg.functionCalls)
+		for (auto& call: _callGraph.functionCalls)
 			call.second -= removed;
 
 		currentDepth++;
@@ -151,7 +156,7 @@ map<YulString, size_t> FullInliner::callDepths() const
 	}
 
 	// Only recursive functions left here.
-	for (auto const& fun: cg.functionCalls)
+	for (auto const& fun: _callGraph.functionCalls)
 		depths[fun.first] = currentDepth;
 
 	return depths;
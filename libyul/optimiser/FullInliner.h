@@ -22,6 +22,7 @@
 
 #include <libyul/ASTForward.h>
 
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDispenser.h>
@@ -93,12 +94,13 @@ public:
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect, AnalysisManager& _analyses);
 	void run(Pass _pass);
 
 	/// @returns a map containing the maximum depths of a call chain starting at each
-	/// function. For recursive functions, the value is one larger than for all others.
-	std::map<YulString, size_t> callDepths() const;
+	/// function, given the call graph of the AST. For recursive functions, the value
+	/// is one larger than for all others.
+	std::map<YulString, size_t> callDepths(CallGraph _callGraph) const;
 
 	void updateCodeSize(FunctionDefinition const& _fun);
 	void handleBlock(YulString _currentFunctionName, Block& _block);
@@ -118,6 +120,7 @@ private:
 	std::map<YulString, size_t> m_functionSizes;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
+	AnalysisManager& m_analyses;
 };
 
 /**
@@ -24,7 +24,7 @@
 
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/optimiser/Semantics.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/SideEffects.h>
 #include <libyul/AST.h>
 
@@ -34,10 +34,10 @@ using namespace solidity::yul;
 
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	bool containsMSize = _context.analyses.containsMSize(_ast);
 	LoadResolver{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		_context.analyses.sideEffects(_ast),
 		!containsMSize
 	}(_ast);
 }
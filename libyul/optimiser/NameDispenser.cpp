@@ -46,6 +46,14 @@ NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames)
 {
 }
 
+NameDispenser NameDispenser::derive() const
+{
+	NameDispenser derived(m_dialect, set<YulString>{});
+	derived.m_parent = this;
+	derived.m_counter = m_counter;
+	return derived;
+}
+
 YulString NameDispenser::newName(YulString _nameHint)
 {
 	YulString name = _nameHint;
@@ -58,9 +66,12 @@ YulString NameDispenser::newName(YulString _nameHint)
 	return name;
 }
 
-bool NameDispenser::illegalName(YulString _name)
+bool NameDispenser::illegalName(YulString _name) const
 {
-	return isRestrictedIdentifier(m_dialect, _name) || m_usedNames.count(_name);
+	return
+		isRestrictedIdentifier(m_dialect, _name) ||
+		m_usedNames.count(_name) ||
+		(m_parent && m_parent->illegalName(_name));
 }
 
 void NameDispenser::reset(Block const& _ast)
@@ -35,6 +35,11 @@ struct Dialect;
  * do not conflict with existing names.
  *
  * Tries to keep names short and appends decimals to disambiguate.
+ *
+ * A dispenser can be derived from another one to generate names that do not conflict
+ * with the names used by the parent. Derived dispensers do not modify their parent,
+ * so several of them can be used concurrently, as long as the parent is not modified
+ * at the same time. They do not avoid the names generated by each other, though.
  */
 class NameDispenser
 {
@@ -44,6 +49,10 @@ public:
 	/// Initialize the name dispenser with the given used names.
 	explicit NameDispenser(Dialect const& _dialect, std::set<YulString> _usedNames);
 
+	/// @returns a new dispenser that avoids all names used by this dispenser.
+	/// This dispenser must not be destroyed before the returned one.
+	NameDispenser derive() const;
+
 	/// @returns a currently unused name that should be similar to _nameHint.
 	YulString newName(YulString _nameHint);
 
@@ -51,10 +60,12 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
+	/// @returns the used names. For derived dispensers, this does not include the names
+	/// used by the parent.
 	std::set<YulString> const& usedNames() { return m_usedNames; }
 
 	/// Returns true if `_name` is either used or is a restricted identifier.
-	bool illegalName(YulString _name);
+	bool illegalName(YulString _name) const;
 
 	/// Resets `m_usedNames` with *only* the names that are used in the AST. Also resets value of
 	/// `m_counter` to zero.
@@ -62,6 +73,7 @@ public:
 
 private:
 	Dialect const& m_dialect;
+	NameDispenser const* m_parent = nullptr;
 	std::set<YulString> m_usedNames;
 	std::set<YulString> m_reservedNames;
 	size_t m_counter = 0;
@@ -31,12 +31,15 @@ struct Dialect;
 struct Block;
 class YulString;
 class NameDispenser;
+class AnalysisManager;
 
 struct OptimiserStepContext
 {
 	Dialect const& dialect;
 	NameDispenser& dispenser;
 	std::set<YulString> const& reservedIdentifiers;
+	/// Cached analyses of the whole code, shared between the steps.
+	AnalysisManager& analyses;
 };
 
 
@@ -31,6 +31,8 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Algorithms.h>
 
+#include <utility>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -72,6 +74,18 @@ SideEffectsCollector::SideEffectsCollector(
 	operator()(_ast);
 }
 
+SideEffectsCollector::SideEffectsCollector(
+	Dialect const& _dialect,
+	Block const& _ast,
+	map<YulString, SideEffects> const* _functionSideEffects,
+	unordered_map<Block const*, SideEffects>& _blockSideEffects
+):
+	SideEffectsCollector(_dialect, _functionSideEffects)
+{
+	m_blockSideEffects = &_blockSideEffects;
+	operator()(_ast);
+}
+
 void SideEffectsCollector::operator()(FunctionCall const& _functionCall)
 {
 	ASTWalker::operator()(_functionCall);
@@ -85,6 +99,25 @@ void SideEffectsCollector::operator()(FunctionCall const& _functionCall)
 		m_sideEffects += SideEffects::worst();
 }
 
+void SideEffectsCollector::operator()(Block const& _block)
+{
+	if (!m_blockSideEffects)
+	{
+		ASTWalker::operator()(_block);
+		return;
+	}
+
+	auto blockSideEffects = m_blockSideEffects->find(&_block);
+	if (blockSideEffects == m_blockSideEffects->end())
+	{
+		SideEffects outerSideEffects = std::exchange(m_sideEffects, SideEffects{});
+		ASTWalker::operator()(_block);
+		blockSideEffects = m_blockSideEffects->emplace(&_block, m_sideEffects).first;
+		m_sideEffects = outerSideEffects;
+	}
+	m_sideEffects += blockSideEffects->second;
+}
+
 bool MSizeFinder::containsMSize(Dialect const& _dialect, Block const& _ast)
 {
 	MSizeFinder finder(_dialect);
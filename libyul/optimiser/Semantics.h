@@ -27,6 +27,7 @@
 #include <libyul/AST.h>
 
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -59,9 +60,19 @@ public:
 		ForLoop const& _ast,
 		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
 	);
+	/// Collects the side effects of @a _ast and stores those of @a _ast and all blocks nested
+	/// in it in @a _blockSideEffects. Blocks that already have an entry there are not visited
+	/// again, so the entry of a block has to be removed before the block is modified.
+	SideEffectsCollector(
+		Dialect const& _dialect,
+		Block const& _ast,
+		std::map<YulString, SideEffects> const* _functionSideEffects,
+		std::unordered_map<Block const*, SideEffects>& _blockSideEffects
+	);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _functionCall) override;
+	void operator()(Block const& _block) override;
 
 	bool movable() const { return m_sideEffects.movable; }
 
@@ -112,6 +123,8 @@ public:
 private:
 	Dialect const& m_dialect;
 	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
+	/// Side effects of blocks, reused instead of visiting the blocks again if provided.
+	std::unordered_map<Block const*, SideEffects>* m_blockSideEffects = nullptr;
 	SideEffects m_sideEffects;
 };
 
@@ -159,6 +159,17 @@ bool StackCompressor::run(
 	bool _optimizeStackAllocation,
 	size_t _maxIterations
 )
+{
+	IncrementalCompilabilityChecker compilabilityChecker(_dialect, _optimizeStackAllocation);
+	return run(_dialect, _object, compilabilityChecker, _maxIterations);
+}
+
+bool StackCompressor::run(
+	Dialect const& _dialect,
+	Object& _object,
+	IncrementalCompilabilityChecker& _compilabilityChecker,
+	size_t _maxIterations
+)
 {
 	yulAssert(
 		_object.code &&
@@ -168,7 +179,8 @@ bool StackCompressor::run(
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
 	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 	{
-		map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+		_compilabilityChecker.update(_object);
+		map<YulString, int> const& stackSurplus = _compilabilityChecker.stackDeficit();
 		if (stackSurplus.empty())
 			return true;
 
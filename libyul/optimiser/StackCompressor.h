@@ -32,6 +32,7 @@ namespace solidity::yul
 struct Dialect;
 struct Object;
 struct FunctionDefinition;
+class IncrementalCompilabilityChecker;
 
 /**
  * Optimisation stage that aggressively rematerializes certain variables in a function to free
@@ -52,6 +53,15 @@ public:
 		bool _optimizeStackAllocation,
 		size_t _maxIterations
 	);
+	/// Try to remove local variables until the AST is compilable, using @a _compilabilityChecker
+	/// to only re-check the functions that changed in each iteration.
+	/// @returns true if it was successful.
+	static bool run(
+		Dialect const& _dialect,
+		Object& _object,
+		IncrementalCompilabilityChecker& _compilabilityChecker,
+		size_t _maxIterations
+	);
 };
 
 }
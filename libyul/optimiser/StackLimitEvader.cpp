@@ -16,7 +16,7 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <libyul/optimiser/StackToMemoryMover.h>
@@ -121,7 +121,7 @@ void StackLimitEvader::run(
 		if (reservedMemory != literalArgumentValue(*memoryGuardCall))
 			return;
 
-	CallGraph callGraph = CallGraphGenerator::callGraph(*_object.code);
+	CallGraph const& callGraph = _context.analyses.callGraph(*_object.code);
 
 	// We cannot move variables in recursive functions to fixed memory offsets.
 	for (YulString function: callGraph.recursiveFunctions())
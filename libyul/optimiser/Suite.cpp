@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
@@ -58,23 +59,24 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
-#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
+#include <libyul/CompilabilityChecker.h>
 #include <libyul/Object.h>
 
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/JobScheduler.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
-#include <libyul/CompilabilityChecker.h>
 
 using namespace std;
 using namespace solidity;
@@ -86,7 +88,8 @@ void OptimiserSuite::run(
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	optional<size_t> _functionParallelism
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -99,13 +102,14 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _functionParallelism);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
 	suite.runSequence("hfgo", ast);
 
 	NameSimplifier::run(suite.m_context, ast);
+	suite.m_analyses.invalidate();
 	// Now the user-supplied part
 	suite.runSequence(_optimisationSequence, ast);
 
@@ -113,12 +117,15 @@ void OptimiserSuite::run(
 	size_t stackCompressorMaxIterations = 16;
 	suite.runSequence("g", ast);
 
+	// Shared by the stack compressor and the stack limit evader, so that only functions
+	// that changed in between are checked again.
+	IncrementalCompilabilityChecker compilabilityChecker(_dialect, _optimizeStackAllocation);
 	// We ignore the return value because we will get a much better error
 	// message once we perform code generation.
 	StackCompressor::run(
 		_dialect,
 		_object,
-		_optimizeStackAllocation,
+		compilabilityChecker,
 		stackCompressorMaxIterations
 	);
 	suite.runSequence("fDnTOc g", ast);
@@ -128,11 +135,11 @@ void OptimiserSuite::run(
 		yulAssert(_meter, "");
 		ConstantOptimiser{*dialect, *_meter}(ast);
 		if (dialect->providesObjectAccess() && _optimizeStackAllocation)
-			StackLimitEvader::run(suite.m_context, _object, CompilabilityChecker{
-				_dialect,
-				_object,
-				_optimizeStackAllocation
-			}.unreachableVariables);
+		{
+			compilabilityChecker.update(_object);
+			suite.m_analyses.invalidate();
+			StackLimitEvader::run(suite.m_context, _object, compilabilityChecker.unreachableVariables());
+		}
 	}
 	else if (dynamic_cast<WasmDialect const*>(&_dialect))
 	{
@@ -144,6 +151,7 @@ void OptimiserSuite::run(
 
 	suite.m_dispenser.reset(ast);
 	NameSimplifier::run(suite.m_context, ast);
+	suite.m_analyses.invalidate();
 	VarNameCleaner::run(suite.m_context, ast);
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
@@ -169,42 +177,87 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 }
 
+namespace
+{
+
+/// @returns the names of the steps that transform every function (and the main block)
+/// without looking at other functions. Running them on each function separately has the
+/// same effect as running them on the whole code, except for the names of new variables.
+set<string> const& functionLocalSteps()
+{
+	static set<string> const steps{
+		DeadCodeEliminator::name,
+		ExpressionJoiner::name,
+		ExpressionSimplifier::name,
+		ForLoopConditionIntoBody::name,
+		ForLoopConditionOutOfBody::name,
+		ForLoopInitRewriter::name,
+		LiteralRematerialiser::name,
+		RedundantAssignEliminator::name,
+		Rematerialiser::name,
+		SSAReverser::name,
+		SSATransform::name,
+		StructuralSimplifier::name,
+		VarDeclInitializer::name
+	};
+	return steps;
+}
+
+/// @returns the names of the steps that keep the call graph, the side effects of functions
+/// and the use of msize intact: they do not rename, add or remove functions, function calls
+/// or loops. The shared analyses do not have to be discarded after running them.
+set<string> const& analysisPreservingSteps()
+{
+	static set<string> const steps{
+		BlockFlattener::name,
+		ExpressionJoiner::name,
+		ExpressionSplitter::name,
+		ForLoopInitRewriter::name,
+		FunctionGrouper::name,
+		FunctionHoister::name,
+		SSAReverser::name,
+		SSATransform::name,
+		VarDeclInitializer::name
+	};
+	return steps;
+}
+
+}
+
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		RedundantAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -345,7 +398,12 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		runStep(*allSteps().at(step), _ast);
+		if (!analysisPreservingSteps().count(step))
+			m_analyses.invalidate();
+#ifndef NDEBUG
+		yulAssert(m_analyses.resultsMatch(_ast), "Step " + step + " changed the shared analyses.");
+#endif
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -361,6 +419,54 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	}
 }
 
+void OptimiserSuite::runStep(OptimiserStep const& _step, Block& _ast)
+{
+	if (
+		m_functionParallelism &&
+		functionLocalSteps().count(_step.name) &&
+		FunctionGrouper::alreadyGrouped(_ast)
+	)
+		runStepOnFunctions(_step, _ast);
+	else
+		_step.run(m_context, _ast);
+}
+
+void OptimiserSuite::runStepOnFunctions(OptimiserStep const& _step, Block& _ast)
+{
+	// Every function gets its own dispenser, so that the names it generates do not depend
+	// on the order in which the functions are processed.
+	vector<NameDispenser> dispensers;
+	vector<function<void()>> jobs;
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		dispensers.emplace_back(m_dispenser.derive());
+		jobs.emplace_back([&, i]() {
+			AnalysisManager analyses{m_context.dialect};
+			OptimiserStepContext context{m_context.dialect, dispensers[i], m_context.reservedIdentifiers, analyses};
+			Block function{_ast.location, {}};
+			function.statements.emplace_back(move(_ast.statements[i]));
+			_step.run(context, function);
+			yulAssert(function.statements.size() == 1, "Step changed the structure of the code.");
+			_ast.statements[i] = move(function.statements.front());
+		});
+	}
+	util::runJobs(jobs, {}, *m_functionParallelism);
+
+	// Names generated for different functions can clash. Resolve the clashes in the order
+	// of the functions to keep the result deterministic.
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		set<YulString> clashes;
+		for (YulString name: dispensers[i].usedNames())
+			if (m_dispenser.illegalName(name))
+				clashes.insert(name);
+			else
+				m_dispenser.markUsed(name);
+		if (!clashes.empty())
+			NameDisplacer{m_dispenser, clashes}.visit(_ast.statements[i]);
+	}
+}
+
 void OptimiserSuite::runSequenceUntilStable(
 	std::vector<string> const& _steps,
 	Block& _ast,
@@ -370,14 +476,37 @@ void OptimiserSuite::runSequenceUntilStable(
 	if (_steps.empty())
 		return;
 
-	size_t codeSize = 0;
+	// Steps are deterministic, so running a step again on code it did not change
+	// last time will not change it either. For each step, this stores the hash of
+	// the code its last run did not change. The hash includes all names, since steps
+	// can behave differently on code that only differs in the names of variables.
+	// Code is only considered unchanged if its hash is equal, so two different pieces
+	// of code are only confused if their hashes collide.
+	map<string, uint64_t> unchangedBy;
+	uint64_t hash = BlockHasher::hashCodeWithNames(_ast);
+	// Sequences usually contain steps that undo each other (e.g. SSATransform and
+	// SSAReverser), so only the code at the end of a round is compared to decide
+	// whether to run another round. Some sequences rename functions or variables
+	// in every round, so names are not taken into account for this.
+	uint64_t roundHash = BlockHasher::hashCodeUpToRenaming(_ast);
 	for (size_t rounds = 0; rounds < maxRounds; ++rounds)
 	{
-		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
-		if (newSize == codeSize)
-			break;
-		codeSize = newSize;
+		for (string const& step: _steps)
+		{
+			auto unchanged = unchangedBy.find(step);
+			if (unchanged != unchangedBy.end() && unchanged->second == hash)
+				continue;
+
+			runSequence(vector<string>{step}, _ast);
 
-		runSequence(_steps, _ast);
+			uint64_t newHash = BlockHasher::hashCodeWithNames(_ast);
+			if (newHash == hash)
+				unchangedBy[step] = hash;
+			hash = newHash;
+		}
+		uint64_t newRoundHash = BlockHasher::hashCodeUpToRenaming(_ast);
+		if (newRoundHash == roundHash)
+			break;
+		roundHash = newRoundHash;
 	}
 }
@@ -25,8 +25,10 @@
 #include <libyul/YulString.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/AnalysisManager.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <optional>
 #include <set>
 #include <string>
 #include <memory>
@@ -58,13 +60,19 @@ public:
 		PrintStep,
 		PrintChanges
 	};
+	/// Optimizes the code of @a _object.
+	/// @param _functionParallelism if set, steps that transform each function independently
+	/// of the others are run on every function separately, using up to the given number of
+	/// threads. The result does not depend on the number of threads, but the names of
+	/// variables introduced by these steps can differ from the ones used if it is not set.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		std::optional<size_t> _functionParallelism = std::nullopt
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -73,6 +81,9 @@ public:
 
 	void runSequence(std::vector<std::string> const& _steps, Block& _ast);
 	void runSequence(std::string const& _stepAbbreviations, Block& _ast);
+	/// Repeats the given steps until a round of them no longer changes the code apart from
+	/// the names of variables and functions, but at most @a maxRounds times. Steps are skipped if the code has not changed
+	/// since a run of the same step that did not change it.
 	void runSequenceUntilStable(
 		std::vector<std::string> const& _steps,
 		Block& _ast,
@@ -88,16 +99,28 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		std::optional<size_t> _functionParallelism = std::nullopt
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
-		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
+		m_analyses{_dialect},
+		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers, m_analyses},
+		m_debug(_debug),
+		m_functionParallelism(_functionParallelism)
 	{}
 
+	/// Runs @a _step on the whole code or, if enabled and possible, on each function separately.
+	void runStep(OptimiserStep const& _step, Block& _ast);
+	/// Runs @a _step separately on the main block and each function of @a _ast,
+	/// which has to be grouped by the FunctionGrouper.
+	void runStepOnFunctions(OptimiserStep const& _step, Block& _ast);
+
 	NameDispenser m_dispenser;
+	/// Analyses shared by the steps. Discarded after every step that might have changed them.
+	AnalysisManager m_analyses;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	std::optional<size_t> m_functionParallelism;
 };
 
 }
@@ -20,6 +20,7 @@
 
 #include <libyul/optimiser/UnusedPruner.h>
 
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
@@ -33,6 +34,18 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
+{
+	bool allowMSizeOptimization = !_context.analyses.containsMSize(_ast);
+	runUntilStabilised(
+		_context.dialect,
+		_ast,
+		allowMSizeOptimization,
+		&_context.analyses.sideEffects(_ast),
+		_context.reservedIdentifiers
+	);
+}
+
 UnusedPruner::UnusedPruner(
 	Dialect const& _dialect,
 	Block& _ast,
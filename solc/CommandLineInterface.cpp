@@ -124,6 +124,7 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -140,6 +141,7 @@ static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strIR = "ir";
@@ -153,6 +155,8 @@ static string const g_strMetadata = "metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
+static string const g_strModelCheckerThreads = "model-checker-threads";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
@@ -163,6 +167,7 @@ static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulSeparateFunctions = "yul-separate-functions";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
@@ -205,6 +210,7 @@ static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
@@ -217,6 +223,7 @@ static string const g_argIR = g_strIR;
 static string const g_argIROptimized = g_strIROptimized;
 static string const g_argEwasm = g_strEwasm;
 static string const g_argExperimentalViaIR = g_strExperimentalViaIR;
+static string const g_argJobs = g_strJobs;
 static string const g_argLibraries = g_strLibraries;
 static string const g_argLink = g_strLink;
 static string const g_argMachine = g_strMachine;
@@ -224,6 +231,8 @@ static string const g_argMetadata = g_strMetadata;
 static string const g_argMetadataHash = g_strMetadataHash;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
+static string const g_argModelCheckerRaceSolvers = g_strModelCheckerRaceSolvers;
+static string const g_argModelCheckerThreads = g_strModelCheckerThreads;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
 static string const g_argNatspecDev = g_strNatspecDev;
 static string const g_argNatspecUser = g_strNatspecUser;
@@ -849,6 +858,21 @@ General Information)").c_str(),
 			g_strExperimentalViaIR.c_str(),
 			"Turn on experimental compilation mode via the IR (EXPERIMENTAL)."
 		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Use up to n threads to generate code for independent contracts and "
+			"to optimize and compile independent sub-assemblies and Yul objects. "
+			"The output does not depend on this setting."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Store the compilation outputs of contracts in the given directory and reuse them "
+			"instead of compiling contracts again whose metadata did not change. "
+			"The SMTChecker also stores the answers of the SMT solvers there. "
+			"Also used with --" + g_argStandardJSON + ".").c_str()
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(boost::join(g_revertStringsArgs, ",")),
@@ -1023,6 +1047,11 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulSeparateFunctions.c_str(),
+			("Run the yul optimization steps that only transform a single function on each function separately, "
+			"using up to --" + g_argJobs + " threads. This changes the names of some introduced variables.").c_str()
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -1040,6 +1069,17 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run the SMT solvers concurrently for each query and use the first answer "
+			"instead of checking that all solvers agree."
+		)
+		(
+			g_strModelCheckerThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Check the verification targets of the CHC engine concurrently "
+			"in up to n copies of the Horn system. Requires the integrated z3 solver."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1274,6 +1314,8 @@ bool CommandLineInterface::processInput()
 			}
 		}
 		StandardCompiler compiler(fileReader);
+		if (m_args.count(g_argCacheDir))
+			compiler.setCacheDirectory(m_args[g_argCacheDir].as<string>());
 		sout() << compiler.compile(std::move(input)) << endl;
 		return true;
 	}
@@ -1351,6 +1393,13 @@ bool CommandLineInterface::processInput()
 			yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
 
+		bool optimizeFunctionsSeparately = m_args.count(g_strYulSeparateFunctions);
+		if (optimizeFunctionsSeparately && !optimize)
+		{
+			serr() << "--" << g_strYulSeparateFunctions << " is invalid if Yul optimizer is disabled" << endl;
+			return false;
+		}
+
 		if (m_args.count(g_argMachine))
 		{
 			string machine = m_args[g_argMachine].as<string>();
@@ -1408,7 +1457,7 @@ bool CommandLineInterface::processInput()
 			"Warning: Yul is still experimental. Please use the output with care." <<
 			endl;
 
-		return assemble(inputLanguage, targetMachine, optimize, yulOptimiserSteps);
+		return assemble(inputLanguage, targetMachine, optimize, yulOptimiserSteps, optimizeFunctionsSeparately);
 	}
 	else if (countEnabledOptions({g_strYulDialect, g_argMachine}) >= 1)
 	{
@@ -1455,6 +1504,22 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_argModelCheckerRaceSolvers))
+		m_modelCheckerSettings.raceSolvers = true;
+
+	if (m_args[g_argModelCheckerThreads].as<unsigned>() == 0)
+	{
+		serr() << "Invalid option for --" << g_argModelCheckerThreads << ": must be at least 1." << endl;
+		return false;
+	}
+	m_modelCheckerSettings.threads = m_args[g_argModelCheckerThreads].as<unsigned>();
+
+	if (m_args[g_argJobs].as<unsigned>() == 0)
+	{
+		serr() << "Invalid option for --" << g_argJobs << ": must be at least 1." << endl;
+		return false;
+	}
+
 	m_compiler = make_unique<CompilerStack>(fileReader);
 
 	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
@@ -1465,7 +1530,12 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argMetadataHash))
 			m_compiler->setMetadataHash(m_metadataHash);
-		if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
+		if (
+			m_args.count(g_argModelCheckerEngine) ||
+			m_args.count(g_argModelCheckerTimeout) ||
+			m_args.count(g_argModelCheckerRaceSolvers) ||
+			!m_args[g_argModelCheckerThreads].defaulted()
+		)
 			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
@@ -1474,6 +1544,25 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		if (m_args.count(g_argExperimentalViaIR))
 			m_compiler->setViaIR(true);
+		m_compiler->setParallelism(m_args[g_argJobs].as<unsigned>());
+		if (m_args.count(g_argCacheDir))
+		{
+			m_compiler->setCacheDirectory(m_args[g_argCacheDir].as<string>());
+
+			set<string> combinedJsonRequests;
+			if (m_args.count(g_argCombinedJson))
+				boost::split(combinedJsonRequests, m_args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
+			set<CompilerStack::CachedOutput> cachedOutputs;
+			if (m_args.count(g_argAsmJson) || combinedJsonRequests.count(g_strAsm))
+				cachedOutputs.insert(CompilerStack::CachedOutput::LegacyAssembly);
+			if (m_args.count(g_argAsm) && !m_args.count(g_argAsmJson))
+				cachedOutputs.insert(CompilerStack::CachedOutput::Assembly);
+			if (m_args.count(g_argGas))
+				cachedOutputs.insert(CompilerStack::CachedOutput::GasEstimates);
+			if (combinedJsonRequests.count(g_strGeneratedSources) || combinedJsonRequests.count(g_strGeneratedSourcesRuntime))
+				cachedOutputs.insert(CompilerStack::CachedOutput::GeneratedSources);
+			m_compiler->setCachedOutputs(move(cachedOutputs));
+		}
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
 		// TODO: Perhaps we should not compile unless requested
@@ -1505,6 +1594,15 @@ bool CommandLineInterface::processInput()
 
 			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
+		if (m_args.count(g_strYulSeparateFunctions))
+		{
+			if (!settings.runYulOptimiser)
+			{
+				serr() << "--" << g_strYulSeparateFunctions << " is invalid if Yul optimizer is disabled" << endl;
+				return false;
+			}
+			settings.optimizeFunctionsSeparately = true;
+		}
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
 		m_compiler->setOptimiserSettings(settings);
 
@@ -1838,10 +1936,12 @@ bool CommandLineInterface::assemble(
 	yul::AssemblyStack::Language _language,
 	yul::AssemblyStack::Machine _targetMachine,
 	bool _optimize,
-	optional<string> _yulOptimiserSteps
+	optional<string> _yulOptimiserSteps,
+	bool _optimizeFunctionsSeparately
 )
 {
 	solAssert(_optimize || !_yulOptimiserSteps.has_value(), "");
+	solAssert(_optimize || !_optimizeFunctionsSeparately, "");
 
 	bool successful = true;
 	map<string, yul::AssemblyStack> assemblyStacks;
@@ -1850,8 +1950,10 @@ bool CommandLineInterface::assemble(
 		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
 		if (_yulOptimiserSteps.has_value())
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+		settings.optimizeFunctionsSeparately = _optimizeFunctionsSeparately;
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
+		stack.setThreads(m_args[g_argJobs].as<unsigned>());
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -61,7 +61,8 @@ private:
 		yul::AssemblyStack::Language _language,
 		yul::AssemblyStack::Machine _targetMachine,
 		bool _optimize,
-		std::optional<std::string> _yulOptimiserSteps = std::nullopt
+		std::optional<std::string> _yulOptimiserSteps = std::nullopt,
+		bool _optimizeFunctionsSeparately = false
 	);
 
 	void outputCompilationResults();
@@ -31,6 +31,8 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/picosha2.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -41,6 +43,9 @@ evmc::VM& EVMHost::getVM(string const& _path)
 {
 	static evmc::VM NullVM{nullptr};
 	static map<string, unique_ptr<evmc::VM>> vms;
+	// Test cases may be set up concurrently (isoltest --jobs).
+	static mutex vmsMutex;
+	lock_guard<mutex> lock(vmsMutex);
 	if (vms.count(_path) == 0)
 	{
 		evmc_loader_error_code errorCode = {};
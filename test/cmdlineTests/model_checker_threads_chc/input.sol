@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+pragma experimental SMTChecker;
+contract test {
+    function f(uint x) public pure {
+		assert(x > 0);
+    }
+    function g(uint y) public pure {
+		assert(y > 0);
+    }
+    function h(uint z) public pure {
+		assert(z >= 0);
+    }
+}
\ No newline at end of file
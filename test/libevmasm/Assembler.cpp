@@ -46,6 +46,38 @@ namespace
 		BOOST_CHECK(output.bytecode.size() > 0);
 		BOOST_CHECK(output.toHex().length() > 0);
 	}
+
+	/// @returns an assembly with code that can be optimised and that contains some
+	/// sub-assemblies which are shared among its other sub-assemblies.
+	shared_ptr<Assembly> nestedAssembly()
+	{
+		auto createSub = [](unsigned _value) {
+			auto sub = make_shared<Assembly>();
+			for (unsigned i = 0; i < 3; ++i)
+			{
+				sub->append(u256(_value));
+				sub->append(u256(i));
+				sub->append(Instruction::ADD);
+				sub->append(u256(0));
+				sub->append(Instruction::MSTORE);
+				AssemblyItem tag = sub->newTag();
+				sub->appendJump(tag);
+				sub->append(tag);
+			}
+			return sub;
+		};
+		shared_ptr<Assembly> shared = createSub(7);
+		shared_ptr<Assembly> root = createSub(1);
+		for (unsigned i = 2; i < 6; ++i)
+		{
+			shared_ptr<Assembly> sub = createSub(i);
+			if (i % 2 == 0)
+				sub->appendSubroutine(shared);
+			root->appendSubroutine(sub);
+		}
+		root->appendSubroutine(shared);
+		return root;
+	}
 }
 
 BOOST_AUTO_TEST_SUITE(Assembler)
@@ -280,6 +312,52 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(item_data)
+{
+	u256 small = 0xffffffffffffffff;
+	u256 large = small + 1;
+	AssemblyItem smallPush(small);
+	AssemblyItem largePush(large);
+	BOOST_CHECK_EQUAL(smallPush.data(), small);
+	BOOST_CHECK_EQUAL(largePush.data(), large);
+	BOOST_CHECK(smallPush != largePush);
+	BOOST_CHECK(smallPush < largePush);
+	BOOST_CHECK(!(largePush < smallPush));
+	BOOST_CHECK(AssemblyItem(large) == largePush);
+	BOOST_CHECK(AssemblyItem(u256(-1)) != largePush);
+	BOOST_CHECK(largePush < AssemblyItem(u256(-1)));
+
+	AssemblyItem copy = largePush;
+	copy.setData(small);
+	BOOST_CHECK(copy == smallPush);
+	BOOST_CHECK_EQUAL(largePush.data(), large);
+	copy.setData(large);
+	BOOST_CHECK(copy == largePush);
+	BOOST_CHECK(AssemblyItem(PushTag, large) != largePush);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_optimisation)
+{
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+
+	shared_ptr<Assembly> sequential = nestedAssembly();
+	sequential->optimise(settings);
+	for (size_t threads: {2u, 3u, 8u})
+	{
+		settings.threads = threads;
+		shared_ptr<Assembly> parallel = nestedAssembly();
+		parallel->optimise(settings);
+		BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+		BOOST_CHECK(parallel->assemble().bytecode == sequential->assemble().bytecode);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -28,9 +28,28 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+
+using namespace std;
+
 namespace solidity::langutil::test
 {
 
+namespace
+{
+
+/// @returns line and column of @a _position by counting line breaks.
+tuple<int, int> lineColumnByScanning(string const& _source, size_t _position)
+{
+	size_t position = min(_source.size(), _position);
+	int line = static_cast<int>(count(_source.begin(), _source.begin() + static_cast<ptrdiff_t>(position), '\n'));
+	size_t lineStart = position == 0 ? string::npos : _source.rfind('\n', position - 1);
+	lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+	return {line, static_cast<int>(position - lineStart)};
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(CharStreamTest)
 
 BOOST_AUTO_TEST_CASE(test_fail)
@@ -48,6 +67,32 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(line_starts)
+{
+	BOOST_CHECK((CharStream("", "source").lineStarts() == vector<size_t>{0}));
+	BOOST_CHECK((CharStream("a\nbc\n\nd", "source").lineStarts() == vector<size_t>{0, 2, 5, 6}));
+	BOOST_CHECK((CharStream("a\r\nb\n", "source").lineStarts() == vector<size_t>{0, 3, 5}));
+}
+
+BOOST_AUTO_TEST_CASE(line_column)
+{
+	for (string const& text: {string{}, string{"\n"}, string{"ab\ncd\r\n\nefg\n"}, string{"x\n\ny"}})
+	{
+		CharStream stream(text, "source");
+		for (size_t position = 0; position <= text.size() + 1; ++position)
+			BOOST_CHECK(stream.translatePositionToLineColumn(static_cast<int>(position)) == lineColumnByScanning(text, position));
+	}
+
+	CharStream stream("ab\ncd\r\n\nefg", "source");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(0), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(2), "ab");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(3), "cd");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(6), "cd");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(7), "");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(8), "efg");
+	BOOST_CHECK_EQUAL(stream.lineAtPosition(100), "efg");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,245 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the persistent SMT query cache.
+ */
+
+#include <libsmtutil/QueryCache.h>
+#include <libsmtutil/SMTPortfolio.h>
+#ifdef HAVE_Z3
+#include <libsmtutil/Z3CHCInterface.h>
+#endif
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+class TemporaryCacheDirectory
+{
+public:
+	TemporaryCacheDirectory():
+		m_path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-smt-cache-%%%%-%%%%"))
+	{}
+	~TemporaryCacheDirectory() { boost::system::error_code error; boost::filesystem::remove_all(m_path, error); }
+
+	boost::filesystem::path const& path() const { return m_path; }
+	size_t entries() const
+	{
+		if (!boost::filesystem::is_directory(m_path))
+			return 0;
+		return static_cast<size_t>(distance(boost::filesystem::directory_iterator(m_path), boost::filesystem::directory_iterator()));
+	}
+
+private:
+	boost::filesystem::path m_path;
+};
+
+/// @returns the answer of a portfolio that only contains the SMT-LIB2 interface
+/// to a query asking for the value of an integer greater than zero.
+pair<CheckResult, vector<string>> checkPositive(ReadCallback::Callback _callback, shared_ptr<QueryCache> _cache)
+{
+	SMTPortfolio solver({}, move(_callback), SMTSolverChoice::None(), {}, false, move(_cache));
+	Expression x = solver.newVariable("x", SortProvider::sintSort);
+	solver.addAssertion(x > 0);
+	return solver.check({x});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTQueryCache)
+
+BOOST_AUTO_TEST_CASE(answers)
+{
+	TemporaryCacheDirectory directory;
+	QueryCache cache(directory.path());
+
+	BOOST_CHECK(!cache.load("z3", "query"));
+	cache.store("z3", "query", CheckResult::SATISFIABLE, QueryCache::valuesToJson({"1", "true"}));
+	auto entry = cache.load("z3", "query");
+	BOOST_REQUIRE(entry);
+	BOOST_CHECK(entry->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(QueryCache::valuesFromJson(entry->second) == vector<string>({"1", "true"}));
+
+	cache.store("z3", "other query", CheckResult::UNSATISFIABLE, QueryCache::valuesToJson({}));
+	entry = cache.load("z3", "other query");
+	BOOST_REQUIRE(entry);
+	BOOST_CHECK(entry->first == CheckResult::UNSATISFIABLE);
+
+	// Answers of other solvers or solver versions are not used.
+	BOOST_CHECK(!cache.load("cvc4", "query"));
+	BOOST_CHECK_EQUAL(directory.entries(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(non_answers_are_not_stored)
+{
+	TemporaryCacheDirectory directory;
+	QueryCache cache(directory.path());
+
+	for (auto result: {CheckResult::UNKNOWN, CheckResult::CONFLICTING, CheckResult::ERROR})
+		cache.store("z3", "query", result, QueryCache::valuesToJson({}));
+	BOOST_CHECK(!cache.load("z3", "query"));
+	BOOST_CHECK_EQUAL(directory.entries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(unreadable_entries)
+{
+	TemporaryCacheDirectory directory;
+	QueryCache cache(directory.path());
+
+	cache.store("z3", "query", CheckResult::SATISFIABLE, QueryCache::valuesToJson({"1"}));
+	BOOST_REQUIRE_EQUAL(directory.entries(), 1);
+	for (auto const& entry: boost::filesystem::directory_iterator(directory.path()))
+		boost::filesystem::ofstream(entry.path()) << "{\"result\": ";
+	BOOST_CHECK(!cache.load("z3", "query"));
+
+	cache.store("z3", "query", CheckResult::UNSATISFIABLE, QueryCache::valuesToJson({}));
+	auto entry = cache.load("z3", "query");
+	BOOST_REQUIRE(entry);
+	BOOST_CHECK(entry->first == CheckResult::UNSATISFIABLE);
+}
+
+BOOST_AUTO_TEST_CASE(counterexample)
+{
+	auto tupleSort = make_shared<TupleSort>(
+		"state_type",
+		vector<string>{"balance", "flag"},
+		vector<SortPointer>{
+			make_shared<ArraySort>(SortProvider::uintSort, SortProvider::sintSort),
+			SortProvider::boolSort
+		}
+	);
+	CHCSolverInterface::CexGraph graph;
+	graph.nodes.emplace(3, Expression("error_target_2", {}, SortProvider::boolSort));
+	graph.nodes.emplace(7, Expression(
+		"summary_f",
+		{
+			Expression(size_t(0)),
+			Expression("tuple_constructor", {
+				Expression::const_array(Expression(make_shared<SortSort>(tupleSort->components[0])), Expression(size_t(5))),
+				Expression(true)
+			}, tupleSort)
+		},
+		SortProvider::boolSort
+	));
+	graph.edges[3] = {7};
+
+	auto json = QueryCache::counterexampleToJson(graph);
+	auto decoded = QueryCache::counterexampleFromJson(json);
+	BOOST_REQUIRE(decoded);
+	BOOST_CHECK(decoded->edges == graph.edges);
+	BOOST_REQUIRE_EQUAL(decoded->nodes.size(), 2);
+	Expression const& summary = decoded->nodes.at(7);
+	BOOST_CHECK_EQUAL(summary.name, "summary_f");
+	BOOST_REQUIRE_EQUAL(summary.arguments.size(), 2);
+	BOOST_CHECK(*summary.arguments[1].sort == *tupleSort);
+	BOOST_CHECK_EQUAL(summary.arguments[1].arguments[0].name, "const_array");
+	BOOST_CHECK_EQUAL(summary.arguments[1].arguments[0].arguments[1].name, "5");
+	BOOST_CHECK(QueryCache::counterexampleToJson(*decoded) == json);
+
+	json["nodes"]["7"]["sort"]["kind"] = "real";
+	BOOST_CHECK(!QueryCache::counterexampleFromJson(json));
+}
+
+BOOST_AUTO_TEST_CASE(portfolio)
+{
+	TemporaryCacheDirectory directory;
+	auto cache = make_shared<QueryCache>(directory.path());
+
+	size_t calls = 0;
+	ReadCallback::Callback solver = [&](string const&, string const&) {
+		++calls;
+		return ReadCallback::Result{true, "sat\n((|EVALEXPR_0| 1))\n"};
+	};
+	auto answer = checkPositive(solver, cache);
+	BOOST_CHECK(answer.first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(answer.second == vector<string>{"1"});
+	BOOST_CHECK_EQUAL(calls, 1);
+	BOOST_CHECK_EQUAL(directory.entries(), 1);
+
+	// The cached answer is used instead of asking the solver again.
+	answer = checkPositive(solver, cache);
+	BOOST_CHECK(answer.first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(answer.second == vector<string>{"1"});
+	BOOST_CHECK_EQUAL(calls, 1);
+
+	// Without a cache, the solver is asked.
+	answer = checkPositive(solver, nullptr);
+	BOOST_CHECK_EQUAL(calls, 2);
+
+	// Unknown answers are not stored.
+	TemporaryCacheDirectory otherDirectory;
+	ReadCallback::Callback unknown = [](string const&, string const&) {
+		return ReadCallback::Result{true, "unknown\n"};
+	};
+	answer = checkPositive(unknown, make_shared<QueryCache>(otherDirectory.path()));
+	BOOST_CHECK(answer.first == CheckResult::UNKNOWN);
+	BOOST_CHECK_EQUAL(otherDirectory.entries(), 0);
+}
+
+#ifdef HAVE_Z3
+BOOST_AUTO_TEST_CASE(horn_system)
+{
+	if (!Z3Interface::available())
+		return;
+
+	TemporaryCacheDirectory directory;
+	auto cache = make_shared<QueryCache>(directory.path());
+	// Asks whether a value larger than 5 is reachable if the only initial value is @a _initial.
+	auto query = [&](string const& _initial) {
+		Z3CHCInterface solver;
+		solver.setQueryCache(cache);
+		SortPointer intSort = SortProvider::uintSort;
+		auto relationSort = make_shared<FunctionSort>(vector<SortPointer>{intSort}, SortProvider::boolSort);
+		auto errorSort = make_shared<FunctionSort>(vector<SortPointer>{}, SortProvider::boolSort);
+		solver.declareVariable("P", relationSort);
+		solver.declareVariable("error", errorSort);
+		solver.declareVariable("x", intSort);
+		Expression x("x", {}, intSort);
+		Expression p("P", {x}, SortProvider::boolSort);
+		Expression error("error", {}, SortProvider::boolSort);
+		solver.registerRelation(Expression("P", {}, relationSort));
+		solver.registerRelation(Expression("error", {}, errorSort));
+		solver.addRule(Expression::implies(x == Expression(_initial, {}, intSort), p), "init");
+		solver.addRule(Expression::implies(p && x > 5, error), "error");
+		return solver.query(error).first;
+	};
+
+	BOOST_CHECK(query("0") == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK_EQUAL(directory.entries(), 1);
+	// The same system in a new Z3 context has the same key.
+	BOOST_CHECK(query("0") == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK_EQUAL(directory.entries(), 1);
+	// A different rule changes the key.
+	BOOST_CHECK(query("7") == CheckResult::SATISFIABLE);
+	BOOST_CHECK_EQUAL(directory.entries(), 2);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
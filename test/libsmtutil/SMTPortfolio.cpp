@@ -0,0 +1,150 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for racing the solvers of an SMTPortfolio.
+ */
+
+#include <libsmtutil/SMTPortfolio.h>
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace std;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+/// Solver that gives a fixed answer, throws or waits until it is interrupted.
+class TestSolver: public SolverInterface
+{
+public:
+	enum class Behaviour { Answer, Throw, WaitForInterrupt };
+
+	explicit TestSolver(Behaviour _behaviour, CheckResult _answer = CheckResult::SATISFIABLE):
+		m_behaviour(_behaviour), m_answer(_answer)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	pair<CheckResult, vector<string>> check(vector<Expression> const&) override
+	{
+		switch (m_behaviour)
+		{
+		case Behaviour::Answer:
+			return {m_answer, {}};
+		case Behaviour::Throw:
+			smtAssert(false, "Test solver failure.");
+			break;
+		case Behaviour::WaitForInterrupt:
+		{
+			unique_lock<mutex> lock(m_mutex);
+			// The timeout only keeps a broken portfolio from blocking the test run.
+			if (m_interrupted.wait_for(lock, chrono::seconds(30), [&]() { return m_interrupts > 0; }))
+				return {CheckResult::UNKNOWN, {}};
+			break;
+		}
+		}
+		return {CheckResult::ERROR, {}};
+	}
+
+	void interrupt() override
+	{
+		lock_guard<mutex> lock(m_mutex);
+		++m_interrupts;
+		m_interrupted.notify_all();
+	}
+
+	size_t interrupts()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_interrupts;
+	}
+
+private:
+	Behaviour m_behaviour;
+	CheckResult m_answer;
+	mutex m_mutex;
+	condition_variable m_interrupted;
+	size_t m_interrupts = 0;
+};
+
+/// @returns a racing portfolio of an SMT-LIB2 interface without responses and the given solvers.
+unique_ptr<SMTPortfolio> racingPortfolio(vector<unique_ptr<SolverInterface>> _solvers)
+{
+	_solvers.insert(_solvers.begin(), make_unique<SMTLib2Interface>());
+	return make_unique<SMTPortfolio>(move(_solvers), nullopt, true);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioRace)
+
+BOOST_AUTO_TEST_CASE(first_answer_interrupts_others)
+{
+	for (size_t run = 0; run < 20; ++run)
+	{
+		auto waiting = make_unique<TestSolver>(TestSolver::Behaviour::WaitForInterrupt);
+		TestSolver& waitingSolver = *waiting;
+		vector<unique_ptr<SolverInterface>> solvers;
+		solvers.emplace_back(make_unique<TestSolver>(TestSolver::Behaviour::Answer, CheckResult::UNSATISFIABLE));
+		solvers.emplace_back(move(waiting));
+		auto portfolio = racingPortfolio(move(solvers));
+
+		BOOST_CHECK(portfolio->check({}).first == CheckResult::UNSATISFIABLE);
+		// The waiting solver is either not started at all or interrupted exactly once.
+		BOOST_CHECK_LE(waitingSolver.interrupts(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(no_answer)
+{
+	vector<unique_ptr<SolverInterface>> solvers;
+	solvers.emplace_back(make_unique<TestSolver>(TestSolver::Behaviour::Answer, CheckResult::ERROR));
+	solvers.emplace_back(make_unique<TestSolver>(TestSolver::Behaviour::Answer, CheckResult::ERROR));
+	auto portfolio = racingPortfolio(move(solvers));
+	// The SMT-LIB2 interface answers unknown to queries without a response.
+	BOOST_CHECK(portfolio->check({}).first == CheckResult::UNKNOWN);
+}
+
+BOOST_AUTO_TEST_CASE(errors_are_rethrown)
+{
+	for (size_t run = 0; run < 20; ++run)
+	{
+		vector<unique_ptr<SolverInterface>> solvers;
+		solvers.emplace_back(make_unique<TestSolver>(TestSolver::Behaviour::Throw));
+		solvers.emplace_back(make_unique<TestSolver>(TestSolver::Behaviour::Answer, CheckResult::UNKNOWN));
+		auto portfolio = racingPortfolio(move(solvers));
+		// As in a sequential run, the error is not hidden by the results of the other solvers.
+		BOOST_CHECK_THROW(portfolio->check({}), SMTLogicError);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -27,8 +27,12 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
 #include <test/Metadata.h>
 
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
 #include <algorithm>
 #include <set>
 
@@ -128,9 +132,10 @@ void expectLinkReferences(Json::Value const& _contractResult, map<string, set<st
 	}
 }
 
-Json::Value compile(string _input)
+Json::Value compile(string _input, string _cacheDirectory = {})
 {
 	StandardCompiler compiler;
+	compiler.setCacheDirectory(move(_cacheDirectory));
 	string output = compiler.compile(std::move(_input));
 	Json::Value ret;
 	BOOST_REQUIRE(util::jsonParseStrict(output, ret));
@@ -1234,6 +1239,43 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_separate_functions)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "details": {
+				"yul": true,
+				"yulDetails": { "separateFunctions": true }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	// The setting changes the generated code, so it has to be part of the metadata.
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(
+		util::convertContainer<set<string>>(yulDetails.getMemberNames()) ==
+		(set<string>{"stackAllocation", "optimizerSteps", "separateFunctions"})
+	);
+	BOOST_CHECK(yulDetails["separateFunctions"].asBool() == true);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1755,6 +1797,281 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(model_checker_threads_same_reports)
+{
+	auto input = [](unsigned _threads) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\npragma experimental SMTChecker;\ncontract C { uint x; uint[] a; function f(uint y) public { x += y; assert(x < 10); } function g() public { a.pop(); assert(x != 3); } function h(uint z) public view { assert(z + x >= x); assert(z > 0); } }"
+				}
+			},
+			"settings": {
+				"modelChecker": { "engine": "chc", "threads": )" + to_string(_threads) + R"( }
+			}
+		}
+		)";
+	};
+
+	Json::Value sequential = compile(input(1));
+	BOOST_CHECK(compile(input(4))["errors"] == sequential["errors"]);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_threads_skip_unsafe_targets)
+{
+	// The assertions in `check` are targets in every public function that calls it.
+	// Once one of them is found unsafe, the others are skipped.
+	auto input = [](unsigned _threads) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\npragma experimental SMTChecker;\ncontract C { uint x; function check(uint y) internal view { assert(y != 7); assert(x < 100); } function f(uint y) public { x = y; check(y); } function g(uint y) public view { check(y); } function h() public view { check(x); } }"
+				}
+			},
+			"settings": {
+				"modelChecker": { "engine": "chc", "threads": )" + to_string(_threads) + R"( }
+			}
+		}
+		)";
+	};
+
+	Json::Value sequential = compile(input(1));
+	BOOST_REQUIRE(sequential["errors"].isArray());
+	for (unsigned threads: {2u, 3u, 8u})
+		BOOST_CHECK(compile(input(threads))["errors"] == sequential["errors"]);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_directory_not_settable_from_input)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { }"
+			}
+		},
+		"settings": {
+			"cacheDirectory": "/tmp/solc-cache"
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"cacheDirectory\""));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { function f() public pure returns (uint) { return 7; } } contract B { function g() public returns (address) { return address(new A()); } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["evm.bytecode", "evm.deployedBytecode", "evm.assembly", "evm.legacyAssembly"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value uncached = compile(input, cacheDirectory.string());
+	BOOST_REQUIRE(containsAtMostWarnings(uncached));
+	BOOST_REQUIRE(boost::filesystem::is_directory(cacheDirectory));
+	vector<boost::filesystem::path> entries;
+	for (auto const& entry: boost::filesystem::directory_iterator(cacheDirectory))
+		entries.push_back(entry.path());
+	BOOST_REQUIRE_EQUAL(entries.size(), 2);
+
+	BOOST_CHECK(compile(input, cacheDirectory.string()) == uncached);
+
+	// Entries are used if they are valid...
+	for (auto const& path: entries)
+	{
+		Json::Value entry;
+		BOOST_REQUIRE(util::jsonParseStrict(util::readFileAsString(path.string()), entry));
+		entry["assembly"] = "cached";
+		boost::filesystem::ofstream(path) << util::jsonCompactPrint(entry);
+	}
+	Json::Value cached = compile(input, cacheDirectory.string());
+	BOOST_CHECK_EQUAL(cached["contracts"]["A.sol"]["A"]["evm"]["assembly"].asString(), "cached");
+	BOOST_CHECK_EQUAL(cached["contracts"]["A.sol"]["B"]["evm"]["assembly"].asString(), "cached");
+
+	// ...and ignored and replaced otherwise.
+	for (auto const& path: entries)
+		boost::filesystem::ofstream(path) << "{\"bytecode\": ";
+	BOOST_CHECK(compile(input, cacheDirectory.string()) == uncached);
+	BOOST_CHECK(compile(input, cacheDirectory.string()) == uncached);
+
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_gas_estimates)
+{
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { uint x; function f() public returns (uint) { return ++x; } function g() internal pure {} }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["evm.bytecode.object", "evm.gasEstimates"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value uncached = compile(input, cacheDirectory.string());
+	BOOST_REQUIRE(containsAtMostWarnings(uncached));
+	BOOST_CHECK(uncached["contracts"]["A.sol"]["A"]["evm"]["gasEstimates"]["creation"].isObject());
+	BOOST_CHECK(uncached["contracts"]["A.sol"]["A"]["evm"]["gasEstimates"]["external"].isObject());
+	BOOST_CHECK(compile(input, cacheDirectory.string()) == uncached);
+
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_warnings)
+{
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	// Code generation warns about the ABI coder of both contracts when compiling B.
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\npragma abicoder v1;\ncontract A { function f() public pure returns (uint) { return 7; } } contract B { function g() public returns (address) { return address(new A()); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"outputSelection": {
+				"A.sol": {
+					"B": ["evm.bytecode.object"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value uncached = compile(input, cacheDirectory.string());
+	BOOST_REQUIRE(containsAtMostWarnings(uncached));
+	size_t abiCoderWarnings = 0;
+	for (auto const& error: uncached["errors"])
+		if (error["errorCode"].asString() == "2066")
+			++abiCoderWarnings;
+	BOOST_REQUIRE_EQUAL(abiCoderWarnings, 2);
+	BOOST_CHECK(compile(input, cacheDirectory.string()) == uncached);
+
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_requested_outputs)
+{
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	auto input = [](string const& _outputs) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract A { function f(uint a) public pure returns (uint) { return a * 7; } }"
+				}
+			},
+			"settings": {
+				"outputSelection": {
+					"*": {
+						"*": [)" + _outputs + R"(]
+					}
+				}
+			}
+		}
+		)";
+	};
+	auto cachedEntry = [&]() {
+		vector<boost::filesystem::path> entries;
+		for (auto const& entry: boost::filesystem::directory_iterator(cacheDirectory))
+			entries.push_back(entry.path());
+		BOOST_REQUIRE_EQUAL(entries.size(), 1);
+		Json::Value entry;
+		BOOST_REQUIRE(util::jsonParseStrict(util::readFileAsString(entries.front().string()), entry));
+		return entry;
+	};
+
+	// Outputs that are not requested are neither computed nor stored...
+	BOOST_REQUIRE(containsAtMostWarnings(compile(input("\"evm.bytecode.object\""), cacheDirectory.string())));
+	Json::Value entry = cachedEntry();
+	BOOST_CHECK(entry["bytecode"].isObject());
+	BOOST_CHECK(!entry.isMember("assembly"));
+	BOOST_CHECK(!entry.isMember("legacyAssembly"));
+	BOOST_CHECK(!entry.isMember("gasEstimates"));
+	BOOST_CHECK(!entry.isMember("generatedSources"));
+
+	// ...and an entry without a requested output is not used.
+	Json::Value withGasEstimates = compile(input("\"evm.bytecode.object\", \"evm.gasEstimates\""), cacheDirectory.string());
+	BOOST_CHECK(withGasEstimates["contracts"]["A.sol"]["A"]["evm"]["gasEstimates"]["external"].isObject());
+	BOOST_CHECK(cachedEntry()["gasEstimates"].isObject());
+	BOOST_CHECK(compile(input("\"evm.bytecode.object\", \"evm.gasEstimates\""), cacheDirectory.string()) == withGasEstimates);
+
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_parallelism)
+{
+	boost::filesystem::path cacheDirectory =
+		boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-cache-%%%%-%%%%");
+	auto input = [](unsigned _parallelism) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": {
+					"content": "contract A { function f(uint a) public pure returns (uint) { return a * 7; } } contract B { function g() public returns (address) { return address(new A()); } }"
+				}
+			},
+			"settings": {
+				"parallelism": )" + to_string(_parallelism) + R"(,
+				"viaIR": true,
+				"optimizer": { "enabled": true },
+				"outputSelection": {
+					"*": {
+						"*": ["evm.bytecode.object", "evm.deployedBytecode.object", "irOptimized"]
+					}
+				}
+			}
+		}
+		)";
+	};
+
+	// The outputs do not depend on the number of threads, so a cache filled
+	// by a sequential compilation can be used by a parallel one.
+	Json::Value sequential = compile(input(1), cacheDirectory.string());
+	BOOST_REQUIRE(containsAtMostWarnings(sequential));
+	BOOST_CHECK(compile(input(8)) == sequential);
+	BOOST_CHECK(compile(input(8), cacheDirectory.string()) == sequential);
+
+	boost::filesystem::remove_all(cacheDirectory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
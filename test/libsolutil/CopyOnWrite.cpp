@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/CopyOnWrite.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+namespace solidity::util::test
+{
+
+namespace
+{
+using SharedMap = CopyOnWrite<std::map<int, int>>;
+}
+
+BOOST_AUTO_TEST_SUITE(CopyOnWriteTests, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(default_constructed_holds_default_value)
+{
+	SharedMap value;
+	BOOST_CHECK(value->empty());
+	BOOST_CHECK(value == SharedMap());
+}
+
+BOOST_AUTO_TEST_CASE(copies_share_value_until_modified)
+{
+	SharedMap original(std::map<int, int>{{1, 2}});
+	SharedMap copy = original;
+	BOOST_CHECK(copy.sharesValueWith(original));
+	BOOST_CHECK(&*copy == &*original);
+
+	copy.mutate()[3] = 4;
+	BOOST_CHECK(!copy.sharesValueWith(original));
+	BOOST_CHECK(copy != original);
+	BOOST_CHECK_EQUAL(original->size(), 1);
+	BOOST_CHECK_EQUAL(copy->size(), 2);
+	BOOST_CHECK_EQUAL(copy->at(1), 2);
+	BOOST_CHECK_EQUAL(copy->at(3), 4);
+}
+
+BOOST_AUTO_TEST_CASE(unshared_value_is_modified_in_place)
+{
+	SharedMap value;
+	std::map<int, int> const* address = &*value;
+	value.mutate()[1] = 2;
+	BOOST_CHECK(&*value == address);
+
+	{
+		SharedMap copy = value;
+		BOOST_CHECK(copy == value);
+	}
+	// The copy is gone, so the value is not shared anymore.
+	value.mutate()[3] = 4;
+	BOOST_CHECK(&*value == address);
+}
+
+BOOST_AUTO_TEST_CASE(values_compare_by_content)
+{
+	SharedMap a(std::map<int, int>{{1, 2}});
+	SharedMap b(std::map<int, int>{{1, 2}});
+	BOOST_CHECK(!a.sharesValueWith(b));
+	BOOST_CHECK(a == b);
+	b.mutate()[1] = 3;
+	BOOST_CHECK(a != b);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,147 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the job scheduler.
+ */
+
+#include <libsolutil/JobScheduler.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// Builds jobs that record the order in which they were run.
+vector<function<void()>> recordingJobs(size_t _count, vector<size_t>& _log, mutex& _logMutex)
+{
+	vector<function<void()>> jobs;
+	for (size_t i = 0; i < _count; ++i)
+		jobs.emplace_back([i, &_log, &_logMutex] {
+			lock_guard<mutex> lock(_logMutex);
+			_log.push_back(i);
+		});
+	return jobs;
+}
+
+/// @returns true if every job in @a _log comes after all of its dependencies.
+bool respectsDependencies(vector<size_t> const& _log, vector<set<size_t>> const& _dependencies)
+{
+	set<size_t> finished;
+	for (size_t job: _log)
+	{
+		for (size_t dependency: _dependencies[job])
+			if (!finished.count(dependency))
+				return false;
+		finished.insert(job);
+	}
+	return true;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(JobSchedulerTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(sequential_order)
+{
+	BOOST_CHECK(sequentialJobOrder({}) == vector<size_t>{});
+	BOOST_CHECK((sequentialJobOrder({{}, {}, {}}) == vector<size_t>{0, 1, 2}));
+	BOOST_CHECK((sequentialJobOrder({{2}, {}, {1}}) == vector<size_t>{1, 2, 0}));
+	BOOST_CHECK((sequentialJobOrder({{1, 3}, {}, {0}, {1}}) == vector<size_t>{1, 3, 0, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(invalid_dependencies)
+{
+	BOOST_CHECK_THROW(sequentialJobOrder({{1}, {0}}), InvalidJobDependencies);
+	BOOST_CHECK_THROW(sequentialJobOrder({{0}}), InvalidJobDependencies);
+	BOOST_CHECK_THROW(sequentialJobOrder({{}, {5}}), InvalidJobDependencies);
+	BOOST_CHECK_THROW(runJobs({[]{}, []{}}, {{}}, 1), InvalidJobDependencies);
+}
+
+BOOST_AUTO_TEST_CASE(single_thread)
+{
+	vector<set<size_t>> dependencies{{3}, {}, {0, 1}, {1}};
+	vector<size_t> log;
+	mutex logMutex;
+	runJobs(recordingJobs(4, log, logMutex), dependencies, 1);
+	BOOST_CHECK(log == sequentialJobOrder(dependencies));
+}
+
+BOOST_AUTO_TEST_CASE(independent_jobs)
+{
+	for (size_t threads: {1u, 2u, 8u, 100u})
+	{
+		vector<size_t> log;
+		mutex logMutex;
+		runJobs(recordingJobs(50, log, logMutex), {}, threads);
+		BOOST_CHECK_EQUAL(log.size(), 50);
+		BOOST_CHECK_EQUAL(set<size_t>(log.begin(), log.end()).size(), 50);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(dependencies_are_respected)
+{
+	vector<set<size_t>> dependencies(40);
+	for (size_t job = 1; job < dependencies.size(); ++job)
+	{
+		dependencies[job].insert((job * 7) % job);
+		if (job > 2)
+			dependencies[job].insert(job / 3);
+	}
+	for (size_t threads: {2u, 4u, 16u})
+	{
+		vector<size_t> log;
+		mutex logMutex;
+		runJobs(recordingJobs(dependencies.size(), log, logMutex), dependencies, threads);
+		BOOST_CHECK_EQUAL(log.size(), dependencies.size());
+		BOOST_CHECK(respectsDependencies(log, dependencies));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(first_exception_in_sequential_order)
+{
+	// Sequential order is 1, 0, 2, 3. Job 2 depends on the failing job 0 and is never run.
+	vector<set<size_t>> dependencies{{1}, {}, {0}, {}};
+	for (size_t threads: {1u, 2u, 4u})
+	{
+		atomic<bool> dependantRun{false};
+		atomic<bool> independentRun{false};
+		vector<function<void()>> jobs{
+			[] { throw runtime_error("first"); },
+			[] {},
+			[&] { dependantRun = true; },
+			[&] { independentRun = true; throw logic_error("second"); }
+		};
+		BOOST_CHECK_THROW(runJobs(jobs, dependencies, threads), runtime_error);
+		BOOST_CHECK(!dependantRun);
+		// Without threads, the first exception stops all further jobs.
+		BOOST_CHECK_EQUAL(independentRun, threads > 1);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
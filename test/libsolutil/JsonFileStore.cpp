@@ -0,0 +1,124 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the store of JSON objects in a directory.
+ */
+
+#include <libsolutil/JsonFileStore.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+class TemporaryDirectory
+{
+public:
+	TemporaryDirectory(): m_path(fs::temp_directory_path() / fs::unique_path("solc-json-store-%%%%-%%%%")) {}
+	~TemporaryDirectory() { boost::system::error_code error; fs::remove_all(m_path, error); }
+
+	fs::path const& path() const { return m_path; }
+	vector<fs::path> files() const
+	{
+		vector<fs::path> result;
+		if (fs::is_directory(m_path))
+			for (auto const& entry: fs::directory_iterator(m_path))
+				result.push_back(entry.path());
+		return result;
+	}
+
+private:
+	fs::path m_path;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(JsonFileStoreTest)
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	TemporaryDirectory directory;
+	JsonFileStore store(directory.path() / "nested");
+	h256 key = keccak256("key");
+
+	BOOST_CHECK(!store.load(key));
+	Json::Value object{Json::objectValue};
+	object["value"] = 1;
+	store.store(key, object);
+	auto loaded = store.load(key);
+	BOOST_REQUIRE(loaded);
+	BOOST_CHECK_EQUAL((*loaded)["value"], 1);
+	BOOST_CHECK_EQUAL((*loaded)["key"], toHex(key.asBytes()));
+	BOOST_CHECK(!store.load(keccak256("other key")));
+
+	object["value"] = 2;
+	store.store(key, object);
+	BOOST_CHECK_EQUAL((*store.load(key))["value"], 2);
+	// No temporary files are left behind.
+	BOOST_CHECK_EQUAL(fs::directory_iterator(directory.path() / "nested")->path().extension(), ".json");
+	BOOST_CHECK_EQUAL(distance(fs::directory_iterator(directory.path() / "nested"), fs::directory_iterator()), 1);
+}
+
+BOOST_AUTO_TEST_CASE(unreadable_objects)
+{
+	TemporaryDirectory directory;
+	JsonFileStore store(directory.path());
+	h256 key = keccak256("key");
+
+	store.store(key, Json::Value{Json::objectValue});
+	BOOST_REQUIRE_EQUAL(directory.files().size(), 1);
+	fs::path file = directory.files().front();
+
+	fs::ofstream(file) << "{\"key\": ";
+	BOOST_CHECK(!store.load(key));
+	fs::ofstream(file) << "[]";
+	BOOST_CHECK(!store.load(key));
+	// Objects stored under a different key are not returned.
+	fs::ofstream(file) << "{\"key\": \"" << toHex(keccak256("other key").asBytes()) << "\"}";
+	BOOST_CHECK(!store.load(key));
+
+	store.store(key, Json::Value{Json::objectValue});
+	BOOST_CHECK(store.load(key));
+}
+
+BOOST_AUTO_TEST_CASE(unwritable_directory)
+{
+	TemporaryDirectory directory;
+	fs::create_directories(directory.path());
+	fs::ofstream(directory.path() / "file") << "";
+	JsonFileStore store(directory.path() / "file");
+	h256 key = keccak256("key");
+
+	// Failures are ignored.
+	store.store(key, Json::Value{Json::objectValue});
+	BOOST_CHECK(!store.load(key));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
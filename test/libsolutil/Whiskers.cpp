@@ -208,6 +208,21 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(same_template_rendered_repeatedly)
+{
+	// The template is only parsed once, but every render uses its own values.
+	string templ = "<a><?c>(<#l><x></l>)<!c>-</c>";
+	vector<map<string, string>> list(2);
+	list[0]["x"] = "1";
+	list[1]["x"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A")("c", true)("l", list).render(), "A(12)");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "B")("c", false)("l", list).render(), "B-");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "C")("c", true)("l", vector<map<string, string>>{}).render(), "C()");
+	Whiskers m(templ);
+	m("c", true)("l", list);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
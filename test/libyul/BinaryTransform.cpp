@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the size prefixes written by the Wasm binary transform.
+ */
+
+#include <libyul/backends/wasm/BinaryTransform.h>
+#include <libyul/backends/wasm/WasmAST.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/LEB128.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// Sizes at which the LEB128 encoding of the size prefix grows by one byte, with their encodings.
+vector<pair<size_t, bytes>> const c_sizes{
+	{127, {0x7f}},
+	{128, {0x80, 0x01}},
+	{16383, {0xff, 0x7f}},
+	{16384, {0x80, 0x80, 0x01}}
+};
+
+bool endsWith(bytes const& _data, bytes const& _suffix)
+{
+	return _data.size() >= _suffix.size() && equal(_suffix.rbegin(), _suffix.rend(), _data.rbegin());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(WasmBinaryTransform, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(function_body_size)
+{
+	for (auto const& [bodySize, encodedSize]: c_sizes)
+	{
+		wasm::FunctionDefinition function{"f", {}, {}, {}, {}};
+		for (size_t i = 0; i < bodySize - 2; ++i)
+			function.body.emplace_back(wasm::Return{});
+		wasm::Module module;
+		module.functions.emplace_back(move(function));
+
+		// No local entries, one byte per return and the final end.
+		bytes body = bytes{0x00} + bytes(bodySize - 2, 0x0f) + bytes{0x0b};
+		bytes code = bytes{0x01} + encodedSize + body;
+		BOOST_CHECK(endsWith(wasm::BinaryTransform::run(module), bytes{0x0a} + lebEncode(code.size()) + code));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(section_size)
+{
+	for (auto const& [sectionSize, encodedSize]: c_sizes)
+	{
+		// The name "c" takes two bytes including its length.
+		bytes data(sectionSize - 2, 0x2a);
+		wasm::Module module;
+		module.customSections["c"] = data;
+
+		// The custom section is followed by the empty code section.
+		bytes expectation = bytes{0x00} + encodedSize + bytes{0x01, 'c'} + data + bytes{0x0a, 0x01, 0x00};
+		BOOST_CHECK(endsWith(wasm::BinaryTransform::run(module), expectation));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
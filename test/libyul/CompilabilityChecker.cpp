@@ -24,6 +24,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libyul/CompilabilityChecker.h>
+#include <libyul/AST.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -34,16 +35,31 @@ namespace solidity::yul::test
 
 namespace
 {
+string format(map<YulString, int> const& _stackDeficit)
+{
+	string out;
+	for (auto const& function: _stackDeficit)
+		out += function.first.str() + ": " + to_string(function.second) + " ";
+	return out;
+}
+
 string check(string const& _input)
 {
 	Object obj;
 	std::tie(obj.code, obj.analysisInfo) = yul::test::parse(_input, false);
 	BOOST_REQUIRE(obj.code);
-	auto functions = CompilabilityChecker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()), obj, true).stackDeficit;
-	string out;
-	for (auto const& function: functions)
-		out += function.first.str() + ": " + to_string(function.second) + " ";
-	return out;
+	return format(CompilabilityChecker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()), obj, true).stackDeficit);
+}
+
+/// Updates @a _checker and @returns its stack deficits after checking that they are the same
+/// as the ones of a full check.
+string checkIncrementally(IncrementalCompilabilityChecker& _checker, Object& _object)
+{
+	_checker.update(_object);
+	CompilabilityChecker fullCheck(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()), _object, true);
+	BOOST_CHECK(_checker.unreachableVariables() == fullCheck.unreachableVariables);
+	BOOST_CHECK_EQUAL(format(_checker.stackDeficit()), format(fullCheck.stackDeficit));
+	return format(_checker.stackDeficit());
 }
 }
 
@@ -219,6 +235,52 @@ BOOST_AUTO_TEST_CASE(also_in_outer_block)
 	BOOST_CHECK_EQUAL(out, "g: 5 : 9 ");
 }
 
+BOOST_AUTO_TEST_CASE(incremental)
+{
+	Object obj;
+	std::tie(obj.code, obj.analysisInfo) = yul::test::parse(R"({
+		{
+			h(calldataload(0))
+		}
+		function f(a, b) -> r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19 {
+		}
+		function h(x) {
+			let r1 := 0
+			let r2 := 0
+			let r3 := 0
+			let r4 := 0
+			let r5 := 0
+			let r6 := 0
+			let r7 := 0
+			let r8 := 0
+			let r9 := 0
+			let r10 := 0
+			let r11 := 0
+			let r12 := 0
+			let r13 := 0
+			let r14 := 0
+			let r15 := 0
+			let r16 := 0
+			let r17 := 0
+			let r18 := 0
+			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
+		}
+	})", false);
+	BOOST_REQUIRE(obj.code);
+	IncrementalCompilabilityChecker checker(EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion()), true);
+	BOOST_CHECK_EQUAL(checkIncrementally(checker, obj), "h: 9 f: 5 ");
+	BOOST_CHECK_EQUAL(checkIncrementally(checker, obj), "h: 9 f: 5 ");
+
+	// Only h changes.
+	std::get<FunctionDefinition>(obj.code->statements.at(2)).body.statements.clear();
+	BOOST_CHECK_EQUAL(checkIncrementally(checker, obj), "f: 5 ");
+
+	// The outermost block changes and h is removed.
+	std::get<Block>(obj.code->statements.at(0)).statements.clear();
+	obj.code->statements.pop_back();
+	BOOST_CHECK_EQUAL(checkIncrementally(checker, obj), "f: 5 ");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the copies of the Ewasm polyfill made by the EVM to Ewasm translator.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/wasm/EVMToEwasmTranslator.h>
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/YulString.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// @returns the names of the functions in the translation of @a _source to Ewasm.
+set<string> translatedFunctions(string const& _source)
+{
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	AssemblyStack stack(evmVersion, AssemblyStack::Language::StrictAssembly, frontend::OptimiserSettings::none());
+	BOOST_REQUIRE(stack.parseAndAnalyze("", _source));
+	// The translator asserts that all called functions are defined.
+	Object translated = EVMToEwasmTranslator(EVMDialect::strictAssemblyForEVMObjects(evmVersion)).run(*stack.parserResult());
+
+	set<string> functions;
+	for (Statement const& statement: translated.code->statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			functions.insert(function->name.str());
+	return functions;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(EVMToEwasmTranslatorTest)
+
+BOOST_AUTO_TEST_CASE(only_reachable_polyfill_functions)
+{
+	set<string> functions = translatedFunctions("{ sstore(0, add(calldataload(0), 1)) }");
+	for (char const* function: {"main", "sstore", "add", "calldataload"})
+		BOOST_CHECK_MESSAGE(functions.count(function), string(function) + " is missing.");
+	// Functions that are only called by other polyfill functions are copied as well.
+	for (char const* function: {"add_carry", "mstore_internal", "mload_internal"})
+		BOOST_CHECK_MESSAGE(functions.count(function), string(function) + " is missing.");
+	for (char const* function: {"sub", "mulmod", "keccak256", "sload"})
+		BOOST_CHECK_MESSAGE(!functions.count(function), string(function) + " is not used.");
+}
+
+BOOST_AUTO_TEST_CASE(polyfill_after_reset)
+{
+	string const source = "{ sstore(0, add(calldataload(0), 1)) }";
+	set<string> functions = translatedFunctions(source);
+	// The parsed polyfill refers to YulStrings, so it has to be parsed again after a reset.
+	YulStringRepository::reset();
+	BOOST_CHECK(translatedFunctions(source) == functions);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,144 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for running optimiser steps on each function separately.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// Counts how often each variable name is declared inside each function and how often each
+/// function name is declared. Variables in different functions may have the same name.
+class DeclarationCounter: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (auto const& var: _varDecl.variables)
+			++m_declarations[{m_currentFunction, var.name}];
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(FunctionDefinition const& _funDef) override
+	{
+		++m_declarations[{{}, _funDef.name}];
+		YulString outerFunction = m_currentFunction;
+		m_currentFunction = _funDef.name;
+		for (auto const& var: _funDef.parameters + _funDef.returnVariables)
+			++m_declarations[{m_currentFunction, var.name}];
+		ASTWalker::operator()(_funDef);
+		m_currentFunction = outerFunction;
+	}
+
+	map<pair<YulString, YulString>, size_t> m_declarations;
+
+private:
+	YulString m_currentFunction;
+};
+
+string const c_source = R"({
+	function f(a, b) -> r {
+		let x := add(a, b)
+		x := mul(x, 2)
+		for { let i := 0 } lt(i, x) { i := add(i, 1) } { r := add(r, sload(i)) }
+	}
+	function g(a) -> r {
+		let x := mul(a, 3)
+		x := add(x, 7)
+		if gt(x, 10) { x := 10 }
+		r := x
+	}
+	function h(a) {
+		let x := calldataload(a)
+		x := add(x, f(a, x))
+		sstore(x, g(x))
+	}
+	h(calldataload(0))
+	sstore(1, f(2, g(3)))
+})";
+
+/// Optimises @a c_source and @returns the result together with the number of declarations
+/// of the most often declared name in a single function.
+pair<string, size_t> optimise(string const& _sequence, optional<size_t> _functionParallelism)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(c_source, dialect, errors);
+	BOOST_REQUIRE(object && errors.empty());
+	object->analysisInfo = analysisInfo;
+
+	GasMeter meter(dialect, false, 200);
+	OptimiserSuite::run(dialect, &meter, *object, true, _sequence, {}, _functionParallelism);
+
+	DeclarationCounter counter;
+	counter(*object->code);
+	size_t maxDeclarations = 0;
+	for (auto const& [name, count]: counter.m_declarations)
+		maxDeclarations = max(maxDeclarations, count);
+	return {AsmPrinter{}(*object->code), maxDeclarations};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulFunctionParallelism)
+
+BOOST_AUTO_TEST_CASE(independent_of_thread_count)
+{
+	for (string const& sequence: vector<string>{"asrj", "aTrmVDtIO", frontend::OptimiserSettings::DefaultYulOptimiserSteps})
+	{
+		auto [sequential, sequentialDeclarations] = optimise(sequence, 1);
+		auto [parallel, parallelDeclarations] = optimise(sequence, 4);
+		BOOST_CHECK_EQUAL(sequential, parallel);
+		BOOST_CHECK_EQUAL(sequentialDeclarations, 1);
+		BOOST_CHECK_EQUAL(parallelDeclarations, 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(names_stay_unique)
+{
+	// The SSA transform introduces the same names in every function, which have to be renamed.
+	auto [code, declarations] = optimise("a", 4);
+	BOOST_CHECK_EQUAL(declarations, 1);
+	BOOST_CHECK(code != optimise("", 4).first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
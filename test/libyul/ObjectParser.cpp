@@ -162,6 +162,89 @@ BOOST_AUTO_TEST_CASE(to_string)
 	BOOST_CHECK_EQUAL(asmStack.print(), expectation);
 }
 
+BOOST_AUTO_TEST_CASE(optimized_object_cache)
+{
+	auto creator = [](string const& _name) {
+		return
+			"object \"" + _name + "\" {\n"
+			"	code { sstore(0, datasize(\"C\")) }\n"
+			"	object \"C\" {\n"
+			"		code { let x := 7 mstore(0, add(x, calldataload(0))) return(0, 32) }\n"
+			"		object \"C_deployed\" { code { sstore(1, 2) } }\n"
+			"	}\n"
+			"}\n";
+	};
+	auto optimizedStack = [](string const& _source, shared_ptr<OptimizedObjectCache> _cache) {
+		auto stack = make_unique<AssemblyStack>(
+			solidity::test::CommonOptions::get().evmVersion(),
+			AssemblyStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::full()
+		);
+		BOOST_REQUIRE(stack->parseAndAnalyze("source", _source));
+		stack->setOptimizedObjectCache(move(_cache));
+		stack->optimize();
+		return stack;
+	};
+
+	auto cache = make_shared<OptimizedObjectCache>();
+	auto first = optimizedStack(creator("A"), cache);
+	auto second = optimizedStack(creator("B"), cache);
+	auto uncached = optimizedStack(creator("B"), nullptr);
+
+	// Both creators share the optimized version of the created object.
+	BOOST_REQUIRE_EQUAL(first->parserResult()->subObjects.size(), 1);
+	BOOST_CHECK(first->parserResult()->subObjects[0] == second->parserResult()->subObjects[0]);
+	BOOST_CHECK(first->parserResult()->subObjects[0] != uncached->parserResult()->subObjects[0]);
+	BOOST_CHECK_EQUAL(second->print(), uncached->print());
+	BOOST_CHECK(
+		second->assemble(AssemblyStack::Machine::EVM).bytecode->bytecode ==
+		uncached->assemble(AssemblyStack::Machine::EVM).bytecode->bytecode
+	);
+}
+
+BOOST_AUTO_TEST_CASE(sibling_objects_in_parallel)
+{
+	string code = R"(
+		object "A" {
+			code {
+				sstore(0, datasize("B"))
+				sstore(1, dataoffset("C.D"))
+				sstore(2, datasize("C.E.F"))
+			}
+			object "B" { code { let x := calldataload(0) sstore(x, add(x, 1)) } }
+			data "d" "abc"
+			object "C" {
+				code { sstore(0, datasize("E.F")) }
+				object "D" { code { mstore(0, 1) return(0, 32) } }
+				object "E" {
+					code { sstore(3, 4) }
+					data "g" hex"0102"
+					object "F" { code { sstore(5, 6) } }
+				}
+			}
+		}
+	)";
+	auto assemble = [&](size_t _threads) {
+		AssemblyStack stack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			AssemblyStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::full()
+		);
+		BOOST_REQUIRE(stack.parseAndAnalyze("source", code));
+		stack.setThreads(_threads);
+		stack.optimize();
+		return make_pair(stack.print(), stack.assemble(AssemblyStack::Machine::EVM).bytecode->bytecode);
+	};
+
+	auto sequential = assemble(1);
+	for (size_t threads: {2u, 3u, 8u})
+	{
+		auto parallel = assemble(threads);
+		BOOST_CHECK_EQUAL(parallel.first, sequential.first);
+		BOOST_CHECK(parallel.second == sequential.second);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -97,216 +97,216 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 		}},
 		{"blockFlattener", [&]() {
 			disambiguate();
-			BlockFlattener::run(*m_context, *m_ast);
+			runOptimiserStep<BlockFlattener>(*m_ast);
 		}},
 		{"constantOptimiser", [&]() {
 			GasMeter meter(dynamic_cast<EVMDialect const&>(*m_dialect), false, 200);
 			ConstantOptimiser{dynamic_cast<EVMDialect const&>(*m_dialect), meter}(*m_ast);
 		}},
-		{"varDeclInitializer", [&]() { VarDeclInitializer::run(*m_context, *m_ast); }},
+		{"varDeclInitializer", [&]() { runOptimiserStep<VarDeclInitializer>(*m_ast); }},
 		{"varNameCleaner", [&]() {
 			disambiguate();
-			FunctionHoister::run(*m_context, *m_ast);
-			FunctionGrouper::run(*m_context, *m_ast);
-			VarNameCleaner::run(*m_context, *m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<FunctionGrouper>(*m_ast);
+			runOptimiserStep<VarNameCleaner>(*m_ast);
 		}},
 		{"forLoopConditionIntoBody", [&]() {
 			disambiguate();
-			ForLoopConditionIntoBody::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopConditionIntoBody>(*m_ast);
 		}},
 		{"forLoopInitRewriter", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
 		}},
 		{"commonSubexpressionEliminator", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			CommonSubexpressionEliminator::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<CommonSubexpressionEliminator>(*m_ast);
 		}},
 		{"conditionalUnsimplifier", [&]() {
 			disambiguate();
-			ConditionalUnsimplifier::run(*m_context, *m_ast);
+			runOptimiserStep<ConditionalUnsimplifier>(*m_ast);
 		}},
 		{"conditionalSimplifier", [&]() {
 			disambiguate();
-			ConditionalSimplifier::run(*m_context, *m_ast);
+			runOptimiserStep<ConditionalSimplifier>(*m_ast);
 		}},
-		{"expressionSplitter", [&]() { ExpressionSplitter::run(*m_context, *m_ast); }},
+		{"expressionSplitter", [&]() { runOptimiserStep<ExpressionSplitter>(*m_ast); }},
 		{"expressionJoiner", [&]() {
 			disambiguate();
-			ExpressionJoiner::run(*m_context, *m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
 		}},
 		{"splitJoin", [&]() {
 			disambiguate();
-			ExpressionSplitter::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
+			runOptimiserStep<ExpressionSplitter>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
 		}},
 		{"functionGrouper", [&]() {
 			disambiguate();
-			FunctionGrouper::run(*m_context, *m_ast);
+			runOptimiserStep<FunctionGrouper>(*m_ast);
 		}},
 		{"functionHoister", [&]() {
 			disambiguate();
-			FunctionHoister::run(*m_context, *m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
 		}},
 		{"expressionInliner", [&]() {
 			disambiguate();
-			ExpressionInliner::run(*m_context, *m_ast);
+			runOptimiserStep<ExpressionInliner>(*m_ast);
 		}},
 		{"fullInliner", [&]() {
 			disambiguate();
-			FunctionHoister::run(*m_context, *m_ast);
-			FunctionGrouper::run(*m_context, *m_ast);
-			ExpressionSplitter::run(*m_context, *m_ast);
-			FullInliner::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<FunctionGrouper>(*m_ast);
+			runOptimiserStep<ExpressionSplitter>(*m_ast);
+			runOptimiserStep<FullInliner>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
 		}},
 		{"mainFunction", [&]() {
 			disambiguate();
-			FunctionGrouper::run(*m_context, *m_ast);
-			MainFunction::run(*m_context, *m_ast);
+			runOptimiserStep<FunctionGrouper>(*m_ast);
+			runOptimiserStep<MainFunction>(*m_ast);
 		}},
 		{"rematerialiser", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			Rematerialiser::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<Rematerialiser>(*m_ast);
 		}},
 		{"expressionSimplifier", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			ExpressionSplitter::run(*m_context, *m_ast);
-			CommonSubexpressionEliminator::run(*m_context, *m_ast);
-			ExpressionSimplifier::run(*m_context, *m_ast);
-			ExpressionSimplifier::run(*m_context, *m_ast);
-			ExpressionSimplifier::run(*m_context, *m_ast);
-			UnusedPruner::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<ExpressionSplitter>(*m_ast);
+			runOptimiserStep<CommonSubexpressionEliminator>(*m_ast);
+			runOptimiserStep<ExpressionSimplifier>(*m_ast);
+			runOptimiserStep<ExpressionSimplifier>(*m_ast);
+			runOptimiserStep<ExpressionSimplifier>(*m_ast);
+			runOptimiserStep<UnusedPruner>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
 		}},
 		{"fullSimplify", [&]() {
 			disambiguate();
-			ExpressionSplitter::run(*m_context, *m_ast);
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			CommonSubexpressionEliminator::run(*m_context, *m_ast);
-			ExpressionSimplifier::run(*m_context, *m_ast);
-			UnusedPruner::run(*m_context, *m_ast);
-			CircularReferencesPruner::run(*m_context, *m_ast);
-			DeadCodeEliminator::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
+			runOptimiserStep<ExpressionSplitter>(*m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<CommonSubexpressionEliminator>(*m_ast);
+			runOptimiserStep<ExpressionSimplifier>(*m_ast);
+			runOptimiserStep<UnusedPruner>(*m_ast);
+			runOptimiserStep<CircularReferencesPruner>(*m_ast);
+			runOptimiserStep<DeadCodeEliminator>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
 		}},
 		{"unusedFunctionParameterPruner", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_object->code);
-			LiteralRematerialiser::run(*m_context, *m_object->code);
-			UnusedFunctionParameterPruner::run(*m_context, *m_object->code);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_object->code);
+			runOptimiserStep<LiteralRematerialiser>(*m_object->code);
+			runOptimiserStep<UnusedFunctionParameterPruner>(*m_object->code);
 		}},
 		{"unusedPruner", [&]() {
 			disambiguate();
-			UnusedPruner::run(*m_context, *m_ast);
+			runOptimiserStep<UnusedPruner>(*m_ast);
 		}},
 		{"circularReferencesPruner", [&]() {
 			disambiguate();
-			FunctionHoister::run(*m_context, *m_ast);
-			CircularReferencesPruner::run(*m_context, *m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<CircularReferencesPruner>(*m_ast);
 		}},
 		{"deadCodeEliminator", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			DeadCodeEliminator::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<DeadCodeEliminator>(*m_ast);
 		}},
 		{"ssaTransform", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			SSATransform::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<SSATransform>(*m_ast);
 		}},
 		{"redundantAssignEliminator", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			RedundantAssignEliminator::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<RedundantAssignEliminator>(*m_ast);
 		}},
 		{"ssaPlusCleanup", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			SSATransform::run(*m_context, *m_ast);
-			RedundantAssignEliminator::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<SSATransform>(*m_ast);
+			runOptimiserStep<RedundantAssignEliminator>(*m_ast);
 		}},
 		{"loadResolver", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			ExpressionSplitter::run(*m_context, *m_ast);
-			CommonSubexpressionEliminator::run(*m_context, *m_ast);
-			ExpressionSimplifier::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<ExpressionSplitter>(*m_ast);
+			runOptimiserStep<CommonSubexpressionEliminator>(*m_ast);
+			runOptimiserStep<ExpressionSimplifier>(*m_ast);
 
-			LoadResolver::run(*m_context, *m_ast);
+			runOptimiserStep<LoadResolver>(*m_ast);
 
-			UnusedPruner::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
-			ExpressionJoiner::run(*m_context, *m_ast);
+			runOptimiserStep<UnusedPruner>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
+			runOptimiserStep<ExpressionJoiner>(*m_ast);
 		}},
 		{"loopInvariantCodeMotion", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			LoopInvariantCodeMotion::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<LoopInvariantCodeMotion>(*m_ast);
 		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			ControlFlowSimplifier::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<ControlFlowSimplifier>(*m_ast);
 		}},
 		{"structuralSimplifier", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			LiteralRematerialiser::run(*m_context, *m_ast);
-			StructuralSimplifier::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<LiteralRematerialiser>(*m_ast);
+			runOptimiserStep<StructuralSimplifier>(*m_ast);
 		}},
 		{"reasoningBasedSimplifier", [&]() {
 			disambiguate();
-			ReasoningBasedSimplifier::run(*m_context, *m_object->code);
+			runOptimiserStep<ReasoningBasedSimplifier>(*m_object->code);
 		}},
 		{"equivalentFunctionCombiner", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			EquivalentFunctionCombiner::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<EquivalentFunctionCombiner>(*m_ast);
 		}},
 		{"ssaReverser", [&]() {
 			disambiguate();
-			SSAReverser::run(*m_context, *m_ast);
+			runOptimiserStep<SSAReverser>(*m_ast);
 		}},
 		{"ssaAndBack", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
 			// apply SSA
-			SSATransform::run(*m_context, *m_ast);
-			RedundantAssignEliminator::run(*m_context, *m_ast);
+			runOptimiserStep<SSATransform>(*m_ast);
+			runOptimiserStep<RedundantAssignEliminator>(*m_ast);
 			// reverse SSA
-			SSAReverser::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			CommonSubexpressionEliminator::run(*m_context, *m_ast);
-			UnusedPruner::run(*m_context, *m_ast);
+			runOptimiserStep<SSAReverser>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<CommonSubexpressionEliminator>(*m_ast);
+			runOptimiserStep<UnusedPruner>(*m_ast);
 		}},
 		{"stackCompressor", [&]() {
 			disambiguate();
-			ForLoopInitRewriter::run(*m_context, *m_ast);
-			FunctionHoister::run(*m_context, *m_ast);
-			FunctionGrouper::run(*m_context, *m_ast);
+			runOptimiserStep<ForLoopInitRewriter>(*m_ast);
+			runOptimiserStep<FunctionHoister>(*m_ast);
+			runOptimiserStep<FunctionGrouper>(*m_ast);
 			size_t maxIterations = 16;
 			StackCompressor::run(*m_dialect, *m_object, true, maxIterations);
-			BlockFlattener::run(*m_context, *m_ast);
+			runOptimiserStep<BlockFlattener>(*m_ast);
 		}},
 		{"wordSizeTransform", [&]() {
 			disambiguate();
-			ExpressionSplitter::run(*m_context, *m_ast);
+			runOptimiserStep<ExpressionSplitter>(*m_ast);
 			WordSizeTransform::run(*m_dialect, *m_dialect, *m_ast, *m_nameDispenser);
 		}},
 		{"fullSuite", [&]() {
@@ -389,9 +389,11 @@ void YulOptimizerTestCommon::disambiguate()
 void YulOptimizerTestCommon::updateContext()
 {
 	m_nameDispenser = make_unique<NameDispenser>(*m_dialect, *m_object->code, m_reservedIdentifiers);
+	m_analyses = make_unique<AnalysisManager>(*m_dialect);
 	m_context = make_unique<OptimiserStepContext>(OptimiserStepContext{
 		*m_dialect,
 		*m_nameDispenser,
-		m_reservedIdentifiers
+		m_reservedIdentifiers,
+		*m_analyses
 	});
 }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 
@@ -52,12 +53,21 @@ public:
 private:
 	void disambiguate();
 	void updateContext();
+	/// Runs the optimiser step @a Step on @a _ast and discards the shared analyses afterwards,
+	/// since the step might have changed the code.
+	template <typename Step>
+	void runOptimiserStep(Block& _ast)
+	{
+		Step::run(*m_context, _ast);
+		m_analyses->invalidate();
+	}
 
 	std::string m_optimizerStep;
 
 	Dialect const* m_dialect = nullptr;
 	std::set<YulString> m_reservedIdentifiers;
 	std::unique_ptr<NameDispenser> m_nameDispenser;
+	std::unique_ptr<AnalysisManager> m_analyses;
 	std::unique_ptr<OptimiserStepContext> m_context;
 
 	std::shared_ptr<Object> m_object;
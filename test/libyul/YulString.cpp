@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString("") == YulString{});
+	BOOST_CHECK(YulString("abc") == YulString(string("abc")));
+	BOOST_CHECK(YulString("abc") != YulString("abd"));
+	BOOST_CHECK(!YulString("abc").empty());
+	BOOST_CHECK_EQUAL(YulString("abc").str(), "abc");
+	BOOST_CHECK_EQUAL(YulString("abc").hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	vector<YulString> strings;
+	for (size_t i = 0; i < 20000; ++i)
+		strings.emplace_back("string_" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_REQUIRE_EQUAL(strings[i].str(), "string_" + to_string(i));
+		BOOST_REQUIRE(strings[i] == YulString("string_" + to_string(i)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 5000;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t] {
+			// Every thread adds the same strings, but in a different order.
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("concurrent_" + to_string((i * (2 * t + 1)) % stringCount));
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			YulString expected("concurrent_" + to_string((i * (2 * t + 1)) % stringCount));
+			BOOST_REQUIRE(results[t][i] == expected);
+			BOOST_REQUIRE_EQUAL(results[t][i].str(), expected.str());
+		}
+}
+
+BOOST_AUTO_TEST_CASE(reset_callbacks)
+{
+	size_t resets = 0;
+	{
+		YulStringRepository::ResetCallback countResets{[&]() { ++resets; }};
+		YulStringRepository::reset();
+		BOOST_CHECK_EQUAL(resets, 1);
+	}
+	// The callback is removed together with the object that registered it.
+	YulStringRepository::reset();
+	BOOST_CHECK_EQUAL(resets, 1);
+}
+
+BOOST_AUTO_TEST_CASE(scopes_of_full_generation_wait)
+{
+	size_t const maxGenerationStrings = YulStringRepository::maxGenerationStrings();
+	YulStringRepository::setMaxGenerationStrings(100);
+	size_t resets = 0;
+	YulStringRepository::ResetCallback countResets{[&]() { ++resets; }};
+	atomic<bool> secondScopeStarted{false};
+	thread secondCompilation;
+	size_t resetsBefore = 0;
+	{
+		YulStringRepository::CompilationScope firstScope;
+		resetsBefore = resets;
+		// More strings than a generation may hold.
+		for (size_t i = 0; i <= 100; ++i)
+			YulString("generation_" + to_string(i));
+		secondCompilation = thread([&] {
+			YulStringRepository::CompilationScope secondScope;
+			secondScopeStarted = true;
+		});
+		// The second scope has to wait for the end of the first one instead of joining it.
+		while (!secondScopeStarted && YulStringRepository::waitingScopes() == 0)
+			this_thread::yield();
+		BOOST_CHECK(!secondScopeStarted);
+		BOOST_CHECK_EQUAL(resets, resetsBefore);
+	}
+	secondCompilation.join();
+	YulStringRepository::setMaxGenerationStrings(maxGenerationStrings);
+	BOOST_CHECK(secondScopeStarted);
+	// The second scope started a new generation.
+	BOOST_CHECK_EQUAL(resets, resetsBefore + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -27,6 +27,7 @@
 
 #include <iostream>
 #include <regex>
+#include <stdexcept>
 #include <string>
 
 namespace fs = boost::filesystem;
@@ -62,7 +63,9 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 	options.add_options()
 		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "Path to editor for opening test files.")
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(1), "Number of threads that run test cases. Failures are reported without prompting if larger than one.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
+		("shard", po::value<std::string>(&shard), "Only run the i-th of n parts of each test suite, given as i/n.")
 		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
 }
 
@@ -77,6 +80,25 @@ bool IsolTestOptions::parse(int _argc, char const* const* _argv)
 	}
 	enforceViaYul = true;
 
+	if (!shard.empty())
+	{
+		std::smatch match;
+		assertThrow(
+			std::regex_match(shard, match, std::regex{"([0-9]+)/([0-9]+)"}),
+			ConfigException,
+			"Invalid shard - must be given as i/n: " + shard
+		);
+		try
+		{
+			shardIndex = std::stoul(match[1]) - 1;
+			shardCount = std::stoul(match[2]);
+		}
+		catch (std::out_of_range const&)
+		{
+			BOOST_THROW_EXCEPTION(ConfigException() << util::errinfo_comment("Invalid shard - number out of range: " + shard));
+		}
+	}
+
 	return res;
 }
 
@@ -89,6 +111,12 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs must be positive.");
+	assertThrow(
+		shardCount > 0 && shardIndex < shardCount,
+		ConfigException,
+		"Invalid shard - i/n requires 1 <= i <= n."
+	);
 }
 
 }
@@ -32,6 +32,14 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	std::string testFilter = std::string{};
+	/// Number of threads that run test cases. Failing test cases are not handled interactively
+	/// if this is larger than one.
+	size_t jobs = 1;
+	/// Only the test cases of each suite whose index modulo @a shardCount is @a shardIndex are run.
+	size_t shardIndex = 0;
+	size_t shardCount = 1;
+	/// Shard as given on the command line, in the form i/n.
+	std::string shard = std::string{};
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
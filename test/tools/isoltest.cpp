@@ -18,6 +18,7 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/JobScheduler.h>
 
 #include <memory>
 #include <test/Common.h>
@@ -29,9 +30,12 @@
 #include <boost/filesystem.hpp>
 
 #include <cstdlib>
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <queue>
 #include <regex>
+#include <sstream>
 #include <utility>
 
 #if defined(_WIN32)
@@ -113,7 +117,8 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case and writes its report to @a _stream.
+	Result process(ostream& _stream);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -133,6 +138,27 @@ private:
 
 	Request handleResponse(bool _exception);
 
+	/// @returns the paths of all test files below @a _path, relative to @a _basepath,
+	/// in lexicographical order.
+	static vector<fs::path> collectTestFiles(fs::path const& _basepath, fs::path const& _path);
+
+	/// Runs the test cases in @a _testFiles one after another and lets the user handle failures.
+	static TestStats processSequentially(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		vector<fs::path> const& _testFiles
+	);
+
+	/// Runs the test cases in @a _testFiles on @a _options.jobs threads. The reports are printed
+	/// in the order of @a _testFiles, independently of the order in which the test cases finish.
+	static TestStats processConcurrently(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		vector<fs::path> const& _testFiles
+	);
+
 	TestCreator m_testCaseCreator;
 	TestOptions const& m_options;
 	TestFilter m_filter;
@@ -147,7 +173,7 @@ private:
 string TestTool::editor;
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool formatted{!m_options.noColor};
 	std::stringstream outputMessages;
@@ -156,7 +182,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -168,21 +194,21 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_stream, "    ", formatted);
+						m_test->printSettings(_stream, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_stream << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -191,13 +217,13 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test" <<
 			(_e.what() ? ": " + string(_e.what()) : ".") <<
 			endl;
@@ -205,7 +231,7 @@ TestTool::Result TestTool::process()
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
@@ -253,27 +279,20 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCreator _testCaseCreator,
-	TestOptions const& _options,
-	fs::path const& _basepath,
-	fs::path const& _path
-)
+vector<fs::path> TestTool::collectTestFiles(fs::path const& _basepath, fs::path const& _path)
 {
+	vector<fs::path> testFiles;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
 
 	while (!paths.empty())
 	{
-		auto currentPath = paths.front();
+		fs::path currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -281,56 +300,143 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
-		{
-			++testCount;
-			paths.pop();
-		}
 		else
+			testFiles.push_back(currentPath);
+	}
+
+	// The order of directory entries depends on the file system.
+	sort(testFiles.begin(), testFiles.end());
+	return testFiles;
+}
+
+TestStats TestTool::processPath(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path
+)
+{
+	vector<fs::path> testFiles;
+	vector<fs::path> allTestFiles = collectTestFiles(_basepath, _path);
+	for (size_t i = 0; i < allTestFiles.size(); ++i)
+		if (i % _options.shardCount == _options.shardIndex)
+			testFiles.push_back(move(allTestFiles[i]));
+
+	if (_options.jobs > 1)
+		return processConcurrently(_testCaseCreator, _options, _basepath, testFiles);
+	else
+		return processSequentially(_testCaseCreator, _options, _basepath, testFiles);
+}
+
+TestStats TestTool::processSequentially(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	vector<fs::path> const& _testFiles
+)
+{
+	int successCount = 0;
+	int testCount = 0;
+	int skippedCount = 0;
+
+	size_t index = 0;
+	while (index < _testFiles.size())
+	{
+		fs::path const& currentPath = _testFiles[index];
+		++testCount;
+
+		if (m_exitRequested)
 		{
-			++testCount;
-			TestTool testTool(
-				_testCaseCreator,
-				_options,
-				fullpath,
-				currentPath.generic_path().string()
-			);
-			auto result = testTool.process();
+			++index;
+			continue;
+		}
 
-			switch(result)
+		TestTool testTool(
+			_testCaseCreator,
+			_options,
+			_basepath / currentPath,
+			currentPath.generic_path().string()
+		);
+		auto result = testTool.process(cout);
+
+		switch(result)
+		{
+		case Result::Failure:
+		case Result::Exception:
+			switch(testTool.handleResponse(result == Result::Exception))
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
-				{
-				case Request::Quit:
-					paths.pop();
-					m_exitRequested = true;
-					break;
-				case Request::Rerun:
-					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
-				case Request::Skip:
-					paths.pop();
-					++skippedCount;
-					break;
-				}
+			case Request::Quit:
+				++index;
+				m_exitRequested = true;
 				break;
-			case Result::Success:
-				paths.pop();
-				++successCount;
+			case Request::Rerun:
+				cout << "Re-running test case..." << endl;
+				--testCount;
 				break;
-			case Result::Skipped:
-				paths.pop();
+			case Request::Skip:
+				++index;
 				++skippedCount;
 				break;
 			}
+			break;
+		case Result::Success:
+			++index;
+			++successCount;
+			break;
+		case Result::Skipped:
+			++index;
+			++skippedCount;
+			break;
 		}
 	}
 
 	return { successCount, testCount, skippedCount };
+}
+
+TestStats TestTool::processConcurrently(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	vector<fs::path> const& _testFiles
+)
+{
+	vector<Result> results(_testFiles.size());
+	vector<optional<string>> reports(_testFiles.size());
+	size_t nextReport = 0;
+	mutex reportMutex;
+
+	vector<function<void()>> jobs;
+	for (size_t i = 0; i < _testFiles.size(); ++i)
+		jobs.emplace_back([&, i]() {
+			ostringstream report;
+			TestTool testTool(
+				_testCaseCreator,
+				_options,
+				_basepath / _testFiles[i],
+				_testFiles[i].generic_path().string()
+			);
+			results[i] = testTool.process(report);
 
+			lock_guard<mutex> lock(reportMutex);
+			reports[i] = report.str();
+			// Print all reports that are not preceded by a test case that is still running.
+			for (; nextReport < reports.size() && reports[nextReport]; ++nextReport)
+			{
+				cout << *reports[nextReport];
+				reports[nextReport] = string{};
+			}
+			cout.flush();
+		});
+	runJobs(jobs, {}, _options.jobs);
+
+	TestStats stats;
+	stats.testCount = static_cast<int>(_testFiles.size());
+	for (Result result: results)
+		if (result == Result::Success)
+			++stats.successCount;
+		else if (result == Result::Skipped)
+			++stats.skippedCount;
+	return stats;
 }
 
 namespace
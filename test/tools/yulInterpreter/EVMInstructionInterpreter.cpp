@@ -68,12 +68,21 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	PagedMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
+	bytes data(_size, 0);
 	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+		if (_sourceOffset + i < _source.size())
+			data[i] = _source[_sourceOffset + i];
+
+	// The target offset wraps around at the maximum of size_t.
+	size_t sizeBeforeWrap = min(_size, numeric_limits<size_t>::max() - _targetOffset);
+	if (sizeBeforeWrap < _size)
+		++sizeBeforeWrap;
+	_target.write(_targetOffset, bytesConstRef(&data).cropped(0, sizeBeforeWrap));
+	_target.write(0, bytesConstRef(&data).cropped(sizeBeforeWrap));
 }
 
 }
@@ -267,7 +276,7 @@ u256 EVMInstructionInterpreter::eval(
 		return 0;
 	case Instruction::MSTORE8:
 		accessMemory(arg[0], 1);
-		m_state.memory[arg[0]] = uint8_t(arg[1] & 0xff);
+		m_state.memory.writeByte(arg[0], uint8_t(arg[1] & 0xff));
 		return 0;
 	case Instruction::SLOAD:
 		return m_state.storage[h256(arg[0])];
@@ -492,10 +501,7 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
@@ -505,8 +511,8 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	h256 word(_value);
+	m_state.memory.write(_offset, word.ref());
 }
 
 
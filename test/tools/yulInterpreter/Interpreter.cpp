@@ -36,7 +36,10 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/algorithm/cxx11/all_of.hpp>
+#include <boost/functional/hash.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <ostream>
 #include <variant>
 
@@ -47,18 +50,92 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+uint8_t PagedMemory::readByte(u256 const& _offset) const
+{
+	auto page = m_pages.find(_offset >> PageBits);
+	if (page == m_pages.end())
+		return 0;
+	return page->second[size_t(_offset & (PageSize - 1))];
+}
+
+void PagedMemory::writeByte(u256 const& _offset, uint8_t _value)
+{
+	write(_offset, bytesConstRef(&_value, 1));
+}
+
+bytes PagedMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	u256 offset = _offset;
+	for (size_t done = 0; done < _size;)
+	{
+		size_t pageOffset = size_t(offset & (PageSize - 1));
+		size_t chunkSize = min(_size - done, PageSize - pageOffset);
+		auto page = m_pages.find(offset >> PageBits);
+		if (page != m_pages.end())
+			copy_n(page->second.begin() + static_cast<ptrdiff_t>(pageOffset), chunkSize, data.begin() + static_cast<ptrdiff_t>(done));
+		done += chunkSize;
+		offset += chunkSize;
+	}
+	return data;
+}
+
+void PagedMemory::write(u256 const& _offset, bytesConstRef _data)
+{
+	u256 offset = _offset;
+	for (size_t done = 0; done < _data.size();)
+	{
+		size_t pageOffset = size_t(offset & (PageSize - 1));
+		size_t chunkSize = min(_data.size() - done, PageSize - pageOffset);
+		bytesConstRef chunk = _data.cropped(done, chunkSize);
+		u256 pageIndex = offset >> PageBits;
+		auto page = m_pages.find(pageIndex);
+		// Writing zeros to a page that does not exist yet does not change anything.
+		if (page == m_pages.end() && any_of(chunk.begin(), chunk.end(), [](uint8_t _byte) { return _byte != 0; }))
+			page = m_pages.emplace(pageIndex, Page{}).first;
+		if (page != m_pages.end())
+			copy(chunk.begin(), chunk.end(), page->second.begin() + static_cast<ptrdiff_t>(pageOffset));
+		done += chunkSize;
+		offset += chunkSize;
+	}
+}
+
+void PagedMemory::forEachNonZeroWord(function<void(u256 const&, h256 const&)> const& _visitor) const
+{
+	vector<u256> pageIndices;
+	for (auto const& page: m_pages)
+		pageIndices.push_back(page.first);
+	sort(pageIndices.begin(), pageIndices.end());
+
+	for (u256 const& pageIndex: pageIndices)
+	{
+		Page const& page = m_pages.at(pageIndex);
+		for (size_t wordOffset = 0; wordOffset < PageSize; wordOffset += 0x20)
+		{
+			h256 word(bytesConstRef(page.data() + wordOffset, 0x20));
+			if (word != h256{})
+				_visitor((pageIndex << PageBits) + wordOffset, word);
+		}
+	}
+}
+
+size_t PagedMemory::PageIndexHash::operator()(u256 const& _pageIndex) const
+{
+	size_t hash = 0;
+	for (u256 index = _pageIndex; index != 0; index >>= 64)
+		boost::hash_combine(hash, static_cast<uint64_t>(index & numeric_limits<uint64_t>::max()));
+	return hash;
+}
+
 void InterpreterState::dumpTraceAndState(ostream& _out) const
 {
 	_out << "Trace:" << endl;
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	memory.forEachNonZeroWord([&](u256 const& _offset, h256 const& _word) {
+		_out << "  " << std::uppercase << std::hex << std::setw(4) << _offset << ": " << _word.hex() << endl;
+	});
 	_out << "Storage dump:" << endl;
 	for (auto const& slot: storage)
 		if (slot.second != h256{})
@@ -29,7 +29,10 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
+#include <functional>
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -67,11 +70,45 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Sparse, byte-addressable memory of the interpreter.
+ *
+ * The address space is split into pages of @a PageSize bytes that are only allocated once
+ * something is written to them. Bytes that were never written read as zero and addresses
+ * wrap around at 2**256.
+ */
+class PagedMemory
+{
+public:
+	static size_t constexpr PageBits = 12;
+	static size_t constexpr PageSize = size_t(1) << PageBits;
+
+	uint8_t readByte(u256 const& _offset) const;
+	void writeByte(u256 const& _offset, uint8_t _value);
+	/// @returns the @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	void write(u256 const& _offset, bytesConstRef _data);
+
+	/// Calls @a _visitor for every 32-byte aligned word that is not zero, in ascending order of
+	/// their offsets.
+	void forEachNonZeroWord(std::function<void(u256 const& _offset, util::h256 const& _word)> const& _visitor) const;
+
+private:
+	using Page = std::array<uint8_t, PageSize>;
+
+	struct PageIndexHash
+	{
+		size_t operator()(u256 const& _pageIndex) const;
+	};
+
+	std::unordered_map<u256, Page, PageIndexHash> m_pages;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	PagedMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
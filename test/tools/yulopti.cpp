@@ -32,6 +32,7 @@
 #include <libyul/Object.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/StackCompressor.h>
@@ -191,13 +192,15 @@ public:
 			char option = static_cast<char>(readStandardInputChar());
 			cout << ' ' << option << endl;
 
-			OptimiserStepContext context{m_dialect, *m_nameDispenser, reservedIdentifiers};
+			AnalysisManager analyses{m_dialect};
+			OptimiserStepContext context{m_dialect, *m_nameDispenser, reservedIdentifiers, analyses};
 
 			auto abbreviationAndName = abbreviationMap.find(option);
 			if (abbreviationAndName != abbreviationMap.end())
 			{
 				OptimiserStep const& step = *OptimiserSuite::allSteps().at(abbreviationAndName->second);
 				step.run(context, *m_ast);
+				analyses.invalidate();
 			}
 			else switch (option)
 			{
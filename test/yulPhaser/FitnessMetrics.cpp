@@ -98,6 +98,35 @@ protected:
 
 BOOST_AUTO_TEST_SUITE(Phaser, *boost::unit_test::label("nooptions"))
 BOOST_AUTO_TEST_SUITE(FitnessMetricsTest)
+BOOST_AUTO_TEST_SUITE(FitnessMetricTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_the_same_values_as_evaluate_for_any_number_of_threads, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes = {
+		m_chromosome,
+		Chromosome("IuO"),
+		Chromosome(""),
+		Chromosome("fDnTO"),
+		Chromosome("IuOfDnTO"),
+		Chromosome("IuO"),
+		Chromosome("vfLTu"),
+		Chromosome("fDnTOIuO"),
+	};
+
+	ProgramSize referenceMetric(m_program, nullptr, m_weights);
+	vector<size_t> expectedValues;
+	for (Chromosome const& chromosome: chromosomes)
+		expectedValues.push_back(referenceMetric.evaluate(chromosome));
+
+	for (size_t threads: vector<size_t>{1, 2, 4})
+	{
+		ProgramSize metric(nullopt, make_shared<ProgramCache>(m_program), m_weights);
+		metric.setThreads(threads);
+		BOOST_TEST(metric.evaluateAll(chromosomes) == expectedValues);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(ProgramBasedMetricTest)
 
 BOOST_FIXTURE_TEST_CASE(optimisedProgram_should_return_optimised_program_even_if_cache_not_available, ProgramBasedMetricFixture)
@@ -397,6 +397,20 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_pass_size_limit_to_caches, FixtureWithPrograms)
+{
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* programCacheSizeLimit = */ 100};
+	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
+
+	BOOST_TEST(caches.size() == m_programs.size());
+	for (size_t i = 0; i < m_programs.size(); ++i)
+	{
+		BOOST_REQUIRE(caches[i] != nullptr);
+		BOOST_REQUIRE(caches[i]->maxTotalCodeSize().has_value());
+		BOOST_TEST(caches[i]->maxTotalCodeSize().value() == 100);
+	}
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
 	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
@@ -29,6 +29,7 @@
 
 #include <string>
 #include <set>
+#include <thread>
 
 using namespace std;
 using namespace solidity::util;
@@ -76,9 +77,9 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheTest)
 
 BOOST_AUTO_TEST_CASE(CacheStats_operator_plus_should_add_stats_together)
 {
-	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}};
-	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}};
-	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}};
+	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}, 16};
+	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}, 26};
+	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}, 42};
 
 	BOOST_CHECK(statsA + statsB == statsC);
 }
@@ -252,6 +253,75 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_least_recently_used_entries_when_over_size_limit, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	size_t sizeLT = optimisedProgram(m_program, "LT").codeSize(CacheStats::StorageWeights);
+
+	// Large enough for everything except "Iu".
+	ProgramCache cache(m_program, sizeI + sizeIu + sizeL + sizeLT - 1);
+
+	cache.optimiseProgram("Iu");
+	cache.optimiseProgram("L");
+	cache.optimiseProgram("I");
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"I", "Iu", "L"}));
+	BOOST_TEST(cache.gatherStats().evictions == 0);
+
+	Program cachedProgram = cache.optimiseProgram("LT");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "LT")));
+	BOOST_TEST((cachedKeys(cache) == set<string>{"I", "L", "LT"}));
+	CacheStats stats = cache.gatherStats();
+	BOOST_TEST(stats.totalCodeSize == sizeI + sizeL + sizeLT);
+	BOOST_TEST(stats.evictions == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_longer_sequences_before_their_prefixes, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+
+	ProgramCache cache(m_program, sizeI + sizeIu);
+	Program cachedProgram = cache.optimiseProgram("IuO");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST((cachedKeys(cache) == set<string>{"I", "Iu"}));
+	BOOST_TEST(cache.gatherStats().totalCodeSize == sizeI + sizeIu);
+	BOOST_TEST(cache.gatherStats().evictions == 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_not_store_anything_if_size_limit_is_zero, ProgramCacheFixture)
+{
+	ProgramCache cache(m_program, 0);
+	Program cachedProgram = cache.optimiseProgram("IuO");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(cache.size() == 0);
+	BOOST_TEST(cache.gatherStats().totalCodeSize == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_be_safe_to_call_from_multiple_threads, ProgramCacheFixture)
+{
+	vector<string> const sequences = {"IuO", "IuOL", "Iu", "LT", "LTIuO", "IuOLT", "L", "IuOLTIuO"};
+
+	vector<string> expectedCode;
+	for (string const& sequence: sequences)
+		expectedCode.push_back(toString(optimisedProgram(m_program, sequence)));
+
+	vector<string> code(sequences.size());
+	vector<thread> threads;
+	for (size_t i = 0; i < sequences.size(); ++i)
+		threads.emplace_back([&, i]() { code[i] = toString(m_programCache.optimiseProgram(sequences[i])); });
+	for (thread& t: threads)
+		t.join();
+
+	BOOST_TEST(code == expectedCode);
+	for (size_t i = 0; i < sequences.size(); ++i)
+		BOOST_TEST(toString(*m_programCache.find(sequences[i])) == expectedCode[i]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
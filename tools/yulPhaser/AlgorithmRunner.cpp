@@ -117,6 +117,8 @@ void AlgorithmRunner::printCacheStats() const
 		m_outputStream << "Total hits: " << totalStats.hits << endl;
 		m_outputStream << "Total misses: " << totalStats.misses << endl;
 		m_outputStream << "Size of cached code: " << totalStats.totalCodeSize << endl;
+		if (totalStats.evictions > 0)
+			m_outputStream << "Total evictions: " << totalStats.evictions << endl;
 	}
 
 	if (disabledCacheCount == m_programCaches.size())
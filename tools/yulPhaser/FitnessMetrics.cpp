@@ -19,14 +19,28 @@
 #include <tools/yulPhaser/FitnessMetrics.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/JobScheduler.h>
 
 #include <cmath>
+#include <functional>
 
 using namespace std;
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> values(_chromosomes.size());
+
+	vector<function<void()>> jobs;
+	for (size_t i = 0; i < _chromosomes.size(); ++i)
+		jobs.emplace_back([&, i]() { values[i] = evaluate(_chromosomes[i]); });
+	runJobs(jobs, {}, m_threads);
+
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -29,6 +29,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +40,9 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * @a evaluateAll() evaluates multiple chromosomes at once, on up to @a threads() threads.
+ * Metrics used with more than one thread must allow concurrent calls to @a evaluate().
  */
 class FitnessMetric
 {
@@ -49,6 +53,15 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// @returns the values of @a evaluate() for all the @a _chromosomes, in the same order.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	size_t threads() const { return m_threads; }
+	void setThreads(size_t _threads) { m_threads = _threads; }
+
+private:
+	size_t m_threads = 1;
 };
 
 /**
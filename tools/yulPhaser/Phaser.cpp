@@ -218,6 +218,7 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["threads"].as<size_t>(),
 	};
 }
 
@@ -230,6 +231,7 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 {
 	assert(_programCaches.size() == _programs.size());
 	assert(_programs.size() > 0 && "Validations should prevent this from being executed with zero files.");
+	assertThrow(_options.threads > 0, BadInput, "The number of threads must be positive.");
 
 	vector<shared_ptr<FitnessMetric>> metrics;
 	switch (_options.metric)
@@ -262,19 +264,27 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	unique_ptr<FitnessMetric> metric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			metric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			metric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			metric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			metric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+
+	metric->setThreads(_options.threads);
+	return metric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -357,6 +367,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("program-cache-size-limit") > 0 ?
+			_arguments["program-cache-size-limit"].as<size_t>() :
+			optional<size_t>{},
 	};
 }
 
@@ -367,7 +380,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(move(program), _options.programCacheSizeLimit) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -473,6 +490,12 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"* " + toString(PhaserMode::PrintOptimisedASTs)
 			).c_str()
 		)
+		(
+			"threads",
+			po::value<size_t>()->value_name("<NUM>")->default_value(1),
+			"Number of threads used to compute the fitness of the members of a population.\n"
+			"The results and the sequence of random numbers do not depend on this value."
+		)
 	;
 	keywordDescription.add(generalDescription);
 
@@ -708,9 +731,17 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
+			"Disabled by default since memory usage is only bounded with --program-cache-size-limit but "
 			"highly recommended if your computer has enough RAM."
 		)
+		(
+			"program-cache-size-limit",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Maximum total size of the programs stored in the cache of each input program, measured "
+			"in the same units as the size of cached code in cache stats (roughly the number of AST nodes). "
+			"The least recently used programs are evicted from the cache when it gets full. "
+			"(default=no limit)"
+		)
 	;
 	keywordDescription.add(cacheDescription);
 
@@ -31,6 +31,7 @@
 #include <libyul/ObjectParser.h>
 #include <libyul/YulString.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/AnalysisManager.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
@@ -201,10 +202,14 @@ unique_ptr<Block> Program::applyOptimisationSteps(
 	// An empty set of reserved identifiers. It could be a constructor parameter but I don't
 	// think it would be useful in this tool. Other tools (like yulopti) have it empty too.
 	set<YulString> const externallyUsedIdentifiers = {};
-	OptimiserStepContext context{_dialect, _nameDispenser, externallyUsedIdentifiers};
+	AnalysisManager analyses{_dialect};
+	OptimiserStepContext context{_dialect, _nameDispenser, externallyUsedIdentifiers, analyses};
 
 	for (string const& step: _optimisationSteps)
+	{
 		OptimiserSuite::allSteps().at(step)->run(context, *_ast);
+		analyses.invalidate();
+	}
 
 	return _ast;
 }
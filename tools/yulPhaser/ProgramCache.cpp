@@ -31,6 +31,7 @@ CacheStats& CacheStats::operator+=(CacheStats const& _other)
 	hits += _other.hits;
 	misses += _other.misses;
 	totalCodeSize += _other.totalCodeSize;
+	evictions += _other.evictions;
 
 	for (auto& [round, count]: _other.roundEntryCounts)
 		if (roundEntryCounts.find(round) != roundEntryCounts.end())
@@ -47,7 +48,8 @@ bool CacheStats::operator==(CacheStats const& _other) const
 		hits == _other.hits &&
 		misses == _other.misses &&
 		totalCodeSize == _other.totalCodeSize &&
-		roundEntryCounts == _other.roundEntryCounts;
+		roundEntryCounts == _other.roundEntryCounts &&
+		evictions == _other.evictions;
 }
 
 Program ProgramCache::optimiseProgram(
@@ -59,32 +61,42 @@ Program ProgramCache::optimiseProgram(
 	for (size_t i = 1; i < _repetitionCount; ++i)
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
+	shared_ptr<Program const> cachedProgram;
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
+	size_t use = 0;
 	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+		lock_guard<mutex> lock(m_mutex);
+		use = ++m_useCount;
+		for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			string prefix = targetOptimisations.substr(0, i);
+			auto pair = m_entries.find(prefix);
+			if (pair != m_entries.end())
+			{
+				touch(pair->second, prefix, use);
+				cachedProgram = pair->second.program;
+				++prefixSize;
+				++m_hits;
+			}
+			else
+				break;
 		}
-		else
-			break;
 	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+	// The shared pointer keeps the program alive even if the entry gets evicted in the meantime,
+	// so it can be copied without holding the lock.
+	Program intermediateProgram = (cachedProgram ? *cachedProgram : m_program);
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		auto program = make_shared<Program const>(intermediateProgram);
+		size_t size = program->codeSize(CacheStats::StorageWeights);
+
+		lock_guard<mutex> lock(m_mutex);
+		insert(targetOptimisations.substr(0, i), move(program), size, use);
 		++m_misses;
 	}
 
@@ -101,7 +113,7 @@ void ProgramCache::startRound(size_t _roundNumber)
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
+			pair = erase(pair);
 		else
 			++pair;
 	}
@@ -110,6 +122,8 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_evictionQueue.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
@@ -119,7 +133,7 @@ Program const* ProgramCache::find(string const& _abbreviatedOptimisationSteps) c
 	if (pair == m_entries.end())
 		return nullptr;
 
-	return &(pair->second.program);
+	return pair->second.program.get();
 }
 
 CacheStats ProgramCache::gatherStats() const
@@ -127,18 +141,59 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
+		/* evictions = */ m_evictions,
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+bool ProgramCache::EvictionOrder::operator()(
+	pair<size_t, string> const& _a,
+	pair<size_t, string> const& _b
+) const
+{
+	if (_a.first != _b.first)
+		return _a.first < _b.first;
+	if (_a.second.size() != _b.second.size())
+		return _a.second.size() > _b.second.size();
+	return _a.second < _b.second;
+}
+
+void ProgramCache::touch(CacheEntry& _entry, string const& _key, size_t _use)
+{
+	m_evictionQueue.erase({_entry.lastUse, _key});
+	m_evictionQueue.emplace(_use, _key);
+	_entry.lastUse = _use;
+	_entry.roundNumber = m_currentRound;
+}
+
+void ProgramCache::insert(string const& _key, shared_ptr<Program const> _program, size_t _size, size_t _use)
+{
+	// A program whose prefix is not cached (because it was evicted while the program was being
+	// optimised) could never be found.
+	if (_key.size() > 1 && m_entries.count(_key.substr(0, _key.size() - 1)) == 0)
+		return;
+
+	if (!m_entries.emplace(_key, CacheEntry{move(_program), m_currentRound, _size, _use}).second)
+		return;
+	m_evictionQueue.emplace(_use, _key);
+	m_totalCodeSize += _size;
+
+	while (m_maxTotalCodeSize.has_value() && m_totalCodeSize > *m_maxTotalCodeSize)
+	{
+		assert(!m_evictionQueue.empty());
+		erase(m_entries.find(m_evictionQueue.begin()->second));
+		++m_evictions;
+	}
+}
+
+map<string, CacheEntry>::iterator ProgramCache::erase(map<string, CacheEntry>::iterator _entry)
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	assert(_entry != m_entries.end());
 
-	return size;
+	m_evictionQueue.erase({_entry->second.lastUse, _entry->first});
+	m_totalCodeSize -= _entry->second.size;
+	return m_entries.erase(_entry);
 }
 
 map<size_t, size_t> ProgramCache::countRoundEntries() const
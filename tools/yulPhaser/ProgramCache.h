@@ -23,6 +23,10 @@
 #include <libyul/optimiser/Metrics.h>
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
 
 namespace solidity::phaser
@@ -31,15 +35,24 @@ namespace solidity::phaser
 /**
  * Structure used by @a ProgramCache to store intermediate programs and metadata associated
  * with them.
+ *
+ * Programs are shared rather than copied so that an entry can be evicted while another thread
+ * is still copying its program.
  */
 struct CacheEntry
 {
-	Program program;
+	std::shared_ptr<Program const> program;
 	size_t roundNumber;
+	/// Size of the program, measured using @a CacheStats::StorageWeights.
+	size_t size;
+	/// Value of the use counter of the cache when the entry was last looked up or inserted.
+	size_t lastUse;
 
-	CacheEntry(Program _program, size_t _roundNumber):
+	CacheEntry(std::shared_ptr<Program const> _program, size_t _roundNumber, size_t _size, size_t _lastUse):
 		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
+		roundNumber(_roundNumber),
+		size(_size),
+		lastUse(_lastUse) {}
 };
 
 /**
@@ -74,6 +87,8 @@ struct CacheStats
 	size_t misses;
 	size_t totalCodeSize;
 	std::map<size_t, size_t> roundEntryCounts;
+	/// Number of entries removed because the cache exceeded its size limit.
+	size_t evictions = 0;
 
 	CacheStats& operator+=(CacheStats const& _other);
 	CacheStats operator+(CacheStats const& _other) const { return CacheStats(*this) += _other; }
@@ -98,15 +113,22 @@ struct CacheStats
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * Since the programs take a lot of memory, the total size of the cached programs (measured the
+ * same way as @a CacheStats::totalCodeSize) can be limited. When an insertion makes the cache
+ * exceed the limit, the least recently used entries are evicted until it fits again. Among
+ * entries used equally recently, longer sequences go first so that a prefix is never evicted
+ * while a longer sequence starting with it is still in the cache.
+ *
+ * @a optimiseProgram() can be called from multiple threads at the same time. The optimisation
+ * steps themselves run outside of the lock, so two threads may occasionally compute the same entry.
+ * The other members must not be called while @a optimiseProgram() is running.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _maxTotalCodeSize = std::nullopt):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -124,9 +146,19 @@ public:
 	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
 	size_t currentRound() const { return m_currentRound; }
+	std::optional<size_t> maxTotalCodeSize() const { return m_maxTotalCodeSize; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	/// Orders the keys in @a m_evictionQueue: least recently used first and, among keys used
+	/// equally recently, longest first.
+	struct EvictionOrder
+	{
+		bool operator()(std::pair<size_t, std::string> const& _a, std::pair<size_t, std::string> const& _b) const;
+	};
+
+	void touch(CacheEntry& _entry, std::string const& _key, size_t _use);
+	void insert(std::string const& _key, std::shared_ptr<Program const> _program, size_t _size, size_t _use);
+	std::map<std::string, CacheEntry>::iterator erase(std::map<std::string, CacheEntry>::iterator _entry);
 	std::map<size_t, size_t> countRoundEntries() const;
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
@@ -134,10 +166,19 @@ private:
 	// A map should be good enough.
 	std::map<std::string, CacheEntry> m_entries;
 
+	/// Pairs of last use and key of all entries, in the order in which they get evicted.
+	std::set<std::pair<size_t, std::string>, EvictionOrder> m_evictionQueue;
+
 	Program m_program;
+	std::optional<size_t> m_maxTotalCodeSize;
+	size_t m_totalCodeSize = 0;
 	size_t m_currentRound = 0;
+	size_t m_useCount = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+	size_t m_evictions = 0;
+	/// Guards the entries and statistics against concurrent calls to @a optimiseProgram().
+	std::mutex m_mutex;
 };
 
 }